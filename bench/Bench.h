@@ -0,0 +1,212 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include "Files.h"
+#include "RandLib.h"
+
+#include "rapidjson/prettywriter.h"
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+namespace junebug
+{
+    namespace bench
+    {
+        // The seed every benchmark starts from, so runs are comparable between builds
+        const unsigned int kSeed = 12345;
+
+        // Measures a span of wall time
+        class Timer
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            void Start() { mStart = Clock::now(); }
+            void Stop() { mElapsed += Clock::now() - mStart; }
+            // Get the total time between every Start() and Stop(), in seconds
+            double Seconds() const { return std::chrono::duration<double>(mElapsed).count(); }
+
+        private:
+            Clock::time_point mStart;
+            Clock::duration mElapsed = Clock::duration::zero();
+        };
+
+        // The timing of a single benchmark
+        struct Result
+        {
+            std::string name, kind, unit;
+            // The number of operations or frames timed in each sample
+            size_t count = 0;
+            // Time per operation or frame across the samples
+            double median = 0.0, min = 0.0, max = 0.0;
+        };
+
+        // Runs benchmarks and collects their results
+        class Suite
+        {
+        public:
+            /// @param samples The number of timed samples per benchmark, after one warm-up sample
+            /// @param filter Only benchmarks whose name contains this are run
+            Suite(int samples, std::string filter) : mSamples(std::max(samples, 1)), mFilter(filter) {}
+
+            // Time a small operation
+            // Results are in nanoseconds per operation
+            /// @param name The benchmark's name
+            /// @param count The number of times to call the operation per sample
+            /// @param op Called with the index of the call, and returns a value that is folded into the checksum
+            template <typename F>
+            void Micro(const std::string &name, size_t count, F &&op)
+            {
+                if (!Enabled(name))
+                    return;
+
+                Run(name, "micro", "ns", count, 1e9, [&](Timer &timer)
+                    {
+                        double sum = 0.0;
+                        timer.Start();
+                        for (size_t i = 0; i < count; i++)
+                            sum += (double)op(i);
+                        timer.Stop();
+                        mChecksum += sum;
+                        return true; });
+            }
+
+            // Time a whole scene over a number of frames
+            // Results are in milliseconds per frame
+            /// @param name The benchmark's name
+            /// @param frames The number of frames each sample runs for
+            /// @param sample Sets up the scene, runs the frames inside the timer it's given, then cleans up
+            /// Returns false if the scene can't run on this machine, which skips the benchmark
+            template <typename F>
+            void Scenario(const std::string &name, size_t frames, F &&sample)
+            {
+                if (!Enabled(name))
+                    return;
+
+                Run(name, "scenario", "ms", frames, 1e3, sample);
+            }
+
+            // Fold a value into the checksum, so the work that produced it can't be optimized away
+            void Consume(double value) { mChecksum += value; }
+
+            // Make sure a scenario behaved as expected
+            // A failed check is reported and fails the whole run, so the benchmarks also guard what they time
+            /// @param name What was checked
+            /// @param passed Whether it behaved as expected
+            void Check(const std::string &name, bool passed)
+            {
+                if (passed)
+                    return;
+                mFailures++;
+                std::cerr << name << ": check failed" << std::endl;
+            }
+            // The number of checks that failed
+            int Failures() const { return mFailures; }
+
+            const std::vector<Result> &GetResults() const { return mResults; }
+
+            // Write every result as JSON
+            void WriteJson(std::ostream &out) const
+            {
+                StringBuffer buffer;
+                PrettyWriter<StringBuffer> writer(buffer);
+
+                writer.StartObject();
+                writer.Key("seed");
+                writer.Uint(kSeed);
+                writer.Key("samples");
+                writer.Int(mSamples);
+#ifdef NDEBUG
+                writer.Key("build");
+                writer.String("release");
+#else
+                writer.Key("build");
+                writer.String("debug");
+#endif
+                writer.Key("checksum");
+                writer.Double(mChecksum);
+
+                writer.Key("results");
+                writer.StartArray();
+                for (const Result &result : mResults)
+                {
+                    writer.StartObject();
+                    writer.Key("name");
+                    writer.String(result.name.c_str());
+                    writer.Key("kind");
+                    writer.String(result.kind.c_str());
+                    writer.Key("unit");
+                    writer.String(result.unit.c_str());
+                    writer.Key("count");
+                    writer.Uint64(result.count);
+                    writer.Key("median");
+                    writer.Double(result.median);
+                    writer.Key("min");
+                    writer.Double(result.min);
+                    writer.Key("max");
+                    writer.Double(result.max);
+                    writer.EndObject();
+                }
+                writer.EndArray();
+                writer.EndObject();
+
+                out << buffer.GetString() << std::endl;
+            }
+
+        private:
+            int mSamples;
+            std::string mFilter;
+            std::vector<Result> mResults;
+            double mChecksum = 0.0;
+            int mFailures = 0;
+
+            bool Enabled(const std::string &name) const
+            {
+                return mFilter.empty() || name.find(mFilter) != std::string::npos;
+            }
+
+            template <typename F>
+            void Run(const std::string &name, const char *kind, const char *unit, size_t count, double scale, F &&sample)
+            {
+                std::vector<double> times;
+                for (int i = 0; i <= mSamples; i++)
+                {
+                    // Every sample sees the same random numbers
+                    Random::Seed(kSeed);
+                    srand(kSeed);
+
+                    Timer timer;
+                    if (!sample(timer))
+                    {
+                        std::cerr << name << ": skipped" << std::endl;
+                        return;
+                    }
+
+                    // The first sample only warms up caches and allocators
+                    if (i > 0)
+                        times.push_back(timer.Seconds() * scale / std::max(count, (size_t)1));
+                }
+                std::sort(times.begin(), times.end());
+
+                Result result;
+                result.name = name;
+                result.kind = kind;
+                result.unit = unit;
+                result.count = count;
+                result.median = times[times.size() / 2];
+                result.min = times.front();
+                result.max = times.back();
+                mResults.push_back(result);
+
+                // Progress goes to stderr, since the engine logs to stdout
+                std::cerr << name << ": " << result.median << " " << unit << std::endl;
+            }
+        };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,481 @@
+#define SDL_MAIN_HANDLED
+
+#include <junebug.h>
+#include <components.h>
+#include "Twerp.h"
+#include "Bench.h"
+
+#include <fstream>
+#include <cfloat>
+using namespace junebug;
+using namespace junebug::bench;
+
+// Register a solid square sprite without touching the disk
+// Headless games only keep the frame's size, so the same sprite works with or without a renderer
+static void AddBoxSprite(Game *game, const std::string &name, Vec2<int> size)
+{
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, size.x, size.y, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_FillRect(surface, nullptr, SDL_MapRGBA(surface->format, 255, 255, 255, 255));
+    TextureRegion frame = game->AddTextureSurface(name + ".png", surface);
+    SDL_FreeSurface(surface);
+
+    std::shared_ptr<Sprite> sprite(new Sprite());
+    sprite->AddFrame(frame);
+    VerticesPtr vertices = std::make_shared<Vertices>();
+    for (auto &point : squareCollider)
+        vertices->push_back(Vertex(point.x * size.x, point.y * size.y));
+    sprite->SetVertices(vertices);
+
+    game->AddSprite(game->GetAssetPaths().sprites + name, sprite);
+}
+
+// A short-lived actor, like a bullet
+class BenchBullet : public VisualActor
+{
+};
+
+// Fires a burst of bullets and clears them all in the same update
+class BenchSpawner : public Actor
+{
+public:
+    int burst = 1000;
+
+    void Update(float dt) override
+    {
+        for (int i = 0; i < burst; i++)
+            new BenchBullet();
+
+        // Clearing while another actor list is held still has to catch the bullets that were just fired
+        for (BenchSpawner *spawner : Game::Get()->GetActors<BenchSpawner>())
+        {
+            if (spawner == this)
+                Actor::DestroyAll<BenchBullet>();
+        }
+    }
+};
+
+// Create and initialize a game for a scenario
+/// @param parallel Whether to update components in passes across every core
+/// @returns The game, or nullptr if it couldn't be initialized
+static Game *StartGame(bool headless, Vec2<int> size, bool parallel = false)
+{
+    Game *game = new Game();
+    GameOptions &options = game->Options();
+    options.headless = headless;
+    options.initFlags = SDL_INIT_VIDEO;
+    options.createDefaultCamera = true;
+    options.defaultCameraSize = Vec2<float>((float)size.x, (float)size.y);
+    options.assetLoaderThreads = 0;
+    options.detectFps = false;
+    options.shouldThreadSleep = false;
+    options.quitOnEscape = false;
+    options.fullscreenOnF11 = false;
+    options.showDefaultDebugCheckpoints = false;
+    // Rendered scenarios shouldn't wait between frames
+    options.fpsTarget = headless ? 60 : 100000;
+    options.renderFlags = SDL_RENDERER_SOFTWARE;
+    options.componentPasses = parallel;
+    options.workerThreads = parallel ? -1 : 0;
+
+    if (!game->Init(size.x, size.y))
+    {
+        std::cerr << "Failed to initialize the game: " << SDL_GetError() << std::endl;
+        delete game;
+        return nullptr;
+    }
+    return game;
+}
+
+// Tear down a scenario's game so the next one starts from nothing
+static void EndGame(Game *game)
+{
+    while (!game->GetAllActors().empty())
+        delete game->GetAllActors().back();
+    while (!game->GetCameras().empty())
+        delete game->GetCameras().back();
+    game->Shutdown();
+    delete game;
+}
+
+// Build a scene file with a number of actors, in the format LoadScene() reads
+static std::string MakeSceneJson(int actorCount)
+{
+    std::string scene = "{\"size\": [4096, 4096], \"layers\": [{\"name\": \"main\", \"depth\": 0}], \"actors\": [";
+    for (int i = 0; i < actorCount; i++)
+    {
+        if (i > 0)
+            scene += ",";
+        scene += "{\"type\": \"PhysicalActor\", \"layer\": \"main\", \"sprite\": \"box" + std::to_string(i % 16) +
+                 "\", \"pos\": [" + std::to_string(Random::GetIntRange(0, 4096)) + ", " + std::to_string(Random::GetIntRange(0, 4096)) +
+                 "], \"scale\": [1.0, 1.0], \"depth\": " + std::to_string(i % 8) + "}";
+    }
+    scene += "]}";
+    return scene;
+}
+
+static void RunMicro(Suite &suite)
+{
+    // Collision bounds for a box and a hexagon that overlap
+    PolygonCollisionBounds box, hexagon;
+    VerticesPtr boxVertices = std::make_shared<Vertices>(), hexVertices = std::make_shared<Vertices>();
+    for (auto &point : squareCollider)
+        boxVertices->push_back(point * 16.0f);
+    for (int i = 0; i < 6; i++)
+        hexVertices->push_back(Vertex(std::cos(i * Pi / 3.0f), std::sin(i * Pi / 3.0f)) * 10.0f);
+    box.LoadVertices(boxVertices);
+    hexagon.LoadVertices(hexVertices);
+    box.UpdateWorldVertices(Vec2<float>(0.0f, 0.0f), 0.0f, Vec2<float>(1.0f, 1.0f), Vec2<int>::Zero);
+    hexagon.UpdateWorldVertices(Vec2<float>(20.0f, 8.0f), 0.0f, Vec2<float>(1.0f, 1.0f), Vec2<int>::Zero);
+
+    suite.Micro("polygon_check_axes", 1000000, [&](size_t i)
+                {
+                    float overlap = FLT_MAX;
+                    Vec2<float> minAxis;
+                    return box.CheckAxes(hexagon, overlap, minAxis) ? overlap : 0.0f; });
+
+    suite.Micro("polygon_transform", 1000000, [&](size_t i)
+                {
+                    hexagon.UpdateWorldVertices(Vec2<float>(20.0f, 8.0f), (float)(i % 360), Vec2<float>(1.0f, 1.0f), Vec2<int>::Zero);
+                    return hexagon.topLeft.x; });
+
+    suite.Micro("twerp_curves", 1000000, [](size_t i)
+                { return Twerp(0.0f, 100.0f, (i % 1000) / 1000.0f, (TwerpType)(i % TWERP_COUNT)); });
+
+    // Lookups only need the game's registries, not a window
+    Game game;
+    AddBoxSprite(&game, "bench_box", Vec2<int>(16, 16));
+    std::string spritePath = game.GetAssetPaths().sprites + "bench_box";
+    SpriteHandle handle = game.FindSprite(spritePath);
+
+    suite.Micro("sprite_load_cached", 1000000, [&](size_t i)
+                { return LoadSprite(spritePath) ? 1 : 0; });
+    suite.Micro("sprite_get_handle", 1000000, [&](size_t i)
+                { return game.GetSprite(handle) ? 1 : 0; });
+
+    game.SetInputMappings({{"jump", {KEY_SPACE, KEY_Z}},
+                           {"left", {KEY_LEFT, KEY_A}},
+                           {"right", {KEY_RIGHT}},
+                           {"attack", {KEY_X}}});
+    suite.Micro("input_lookup", 1000000, [&](size_t i)
+                { return game.Input("jump"); });
+    ActionId jump = game.GetActionId("jump");
+    suite.Micro("input_lookup_id", 1000000, [&](size_t i)
+                { return game.Input(jump); });
+
+    // Actor queries, with the queried type mixed in among other actors
+    for (int i = 0; i < 2000; i++)
+    {
+        Actor *actor = i % 4 == 0 ? new VisualActor() : new Actor();
+        actor->SetId("actor" + std::to_string(i));
+    }
+    suite.Micro("actor_query_type", 1000000, [&](size_t i)
+                { return game.GetActors<VisualActor>().size(); });
+    suite.Micro("actor_find_id", 1000000, [&](size_t i)
+                { return game.GetActor<VisualActor>("actor1000") ? 1 : 0; });
+    while (!game.GetAllActors().empty())
+        delete game.GetAllActors().back();
+
+    Random::Seed(kSeed);
+    std::string scene = MakeSceneJson(2000);
+    suite.Micro("json_scene_parse", 50, [&](size_t i)
+                {
+                    Json json(scene);
+                    Document *doc = json.GetDoc();
+                    return json.IsValid() ? (*doc)["actors"].Size() : 0; });
+}
+
+static void RunScenarios(Suite &suite)
+{
+    const Vec2<int> worldSize(1024, 1024);
+
+    for (auto config : {std::make_pair(250, false), std::make_pair(1000, false), std::make_pair(1000, true)})
+    {
+        int count = config.first;
+        bool parallel = config.second;
+        suite.Scenario("physics_bodies_" + std::to_string(count) + (parallel ? "_parallel" : ""), 120, [&](Timer &timer)
+                       {
+                           Game *game = StartGame(true, worldSize, parallel);
+                           if (!game)
+                               return false;
+                           AddBoxSprite(game, "bench_box", Vec2<int>(8, 8));
+
+                           for (int i = 0; i < count; i++)
+                           {
+                               PhysicalActor *body = new PhysicalActor(Random::GetVec(Vec2<float>::Zero, Vec2<float>(worldSize)), "bench_box");
+                               body->SetVelocity(Random::GetVec(Vec2<float>(-100.0f, -100.0f), Vec2<float>(100.0f, 100.0f)));
+                           }
+                           // Let every actor run its first update before timing
+                           game->Step();
+
+                           timer.Start();
+                           game->Step(120);
+                           timer.Stop();
+
+                           for (Actor *actor : game->GetAllActors())
+                               suite.Consume(static_cast<VisualActor *>(actor)->GetPosition().y);
+                           EndGame(game);
+                           return true; });
+    }
+
+    suite.Scenario("tileset_large", 120, [&](Timer &timer)
+                   {
+                       Game *game = StartGame(true, worldSize);
+                       if (!game)
+                           return false;
+                       game->SetGravity(Vec2<float>(0.0f, 400.0f));
+                       AddBoxSprite(game, "bench_box", Vec2<int>(8, 8));
+                       // A 2x2 sheet of 16x16 tiles
+                       AddBoxSprite(game, "bench_tiles", Vec2<int>(32, 32));
+
+                       // A 512x512 map with a floor and scattered blocks
+                       const int mapSize = 512;
+                       TileGrid tiles(mapSize, mapSize);
+                       for (int y = 0; y < mapSize; y++)
+                       {
+                           for (int x = 0; x < mapSize; x++)
+                           {
+                               if (y >= mapSize - 4 || Random::GetIntRange(0, 9) == 0)
+                                   tiles.Set(x, y, Random::GetIntRange(0, 3));
+                           }
+                       }
+
+                       Tileset *tileset = new Tileset("bench_tiles", Vec2<int>(16, 16));
+                       tileset->SetTiles(std::move(tiles));
+                       VerticesPtr square = std::make_shared<Vertices>();
+                       for (auto &point : squareCollider)
+                           square->push_back(point * 16.0f);
+                       for (int i = 0; i < 4; i++)
+                       {
+                           tileset->GetColliders().push_back(square);
+                           tileset->GetSquareColliders().push_back(true);
+                       }
+                       tileset->SetCollType(CollType::TilesetMerged);
+                       tileset->CalculateNumTiles();
+                       tileset->SetCollLayer("");
+
+                       for (int i = 0; i < 200; i++)
+                           new PhysicalActor(Random::GetVec(Vec2<float>::Zero, Vec2<float>(worldSize)), "bench_box");
+                       game->Step();
+
+                       timer.Start();
+                       for (int frame = 0; frame < 120; frame++)
+                       {
+                           // Edit a few tiles each frame, like a player digging
+                           for (int i = 0; i < 8; i++)
+                           {
+                               Vec2<int> pos(Random::GetIntRange(0, mapSize - 1), Random::GetIntRange(0, mapSize - 1));
+                               tileset->SetTile(pos, tileset->GetTile(pos) == -1 ? 0 : -1);
+                           }
+                           game->Step();
+                       }
+                       timer.Stop();
+
+                       for (Actor *actor : game->GetAllActors())
+                           suite.Consume(static_cast<VisualActor *>(actor)->GetPosition().y);
+                       EndGame(game);
+                       return true; });
+
+    suite.Scenario("spawn_destroy_1000", 120, [&](Timer &timer)
+                   {
+                       Game *game = StartGame(true, worldSize);
+                       if (!game)
+                           return false;
+                       new BenchSpawner();
+                       game->Step();
+                       suite.Check("spawn_destroy_1000: bullets cleared in the update they were fired", game->GetActors<BenchBullet>().empty());
+
+                       timer.Start();
+                       game->Step(120);
+                       timer.Stop();
+
+                       suite.Consume((double)game->GetAllActors().size());
+                       EndGame(game);
+                       return true; });
+
+    suite.Scenario("draw_many_actors", 60, [&](Timer &timer)
+                   {
+                       // The dummy video driver needs no display, and draws through SDL's software renderer
+                       SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+                       Game *game = StartGame(false, Vec2<int>(640, 360));
+                       if (!game)
+                           return false;
+                       AddBoxSprite(game, "bench_box", Vec2<int>(8, 8));
+                       AddBoxSprite(game, "bench_box_alt", Vec2<int>(12, 12));
+
+                       for (int i = 0; i < 5000; i++)
+                       {
+                           VisualActor *actor = new VisualActor(Random::GetVec(Vec2<float>::Zero, Vec2<float>(640.0f, 360.0f)), i % 2 ? "bench_box" : "bench_box_alt");
+                           actor->SetDepth(i % 4);
+                       }
+                       game->Step();
+
+                       timer.Start();
+                       game->Step(60);
+                       timer.Stop();
+
+                       EndGame(game);
+                       return true; });
+
+    suite.Scenario("twerps_10000", 120, [&](Timer &timer)
+                   {
+                       Game *game = StartGame(true, worldSize);
+                       if (!game)
+                           return false;
+
+                       // Mixed curves and lengths, spread across a handful of owners like a busy UI
+                       std::vector<VisualActor *> owners;
+                       for (int i = 0; i < 100; i++)
+                           owners.push_back(new VisualActor());
+                       std::vector<float> values(10000);
+                       for (size_t i = 0; i < values.size(); i++)
+                           TwerpAsync(owners[i % owners.size()], values[i], 0.0f, 100.0f, Random::GetFloatRange(0.5f, 4.0f), (TwerpType)(i % TWERP_COUNT), i % 2 == 0);
+                       for (VisualActor *owner : owners)
+                           TwerpPositionAsync(owner, Vec2<float>::Zero, Vec2<float>(worldSize), 2.0f, TWERP_INOUT_QUAD, true);
+
+                       // A vector and its x share an address, but twerping one doesn't replace the other
+                       Vec2<float> both;
+                       TwerpId whole = TwerpAsync(owners[0], both, Vec2<float>::Zero, Vec2<float>(10.0f, 10.0f), 1.0f);
+                       TwerpId x = TwerpAsync(owners[0], both.x, 0.0f, 10.0f, 1.0f);
+                       game->Step();
+                       suite.Check("twerps_10000: vector and member together", whole != x && ToggleTwerpAsync(whole, 1) && ToggleTwerpAsync(x, 1));
+                       StopTwerpAsync(whole);
+                       StopTwerpAsync(x);
+
+                       timer.Start();
+                       game->Step(120);
+                       timer.Stop();
+
+                       for (float value : values)
+                           suite.Consume(value);
+                       EndGame(game);
+                       return true; });
+
+    suite.Scenario("gamepad_virtual", 600, [&](Timer &timer)
+                   {
+                       Game *game = StartGame(true, worldSize);
+                       if (!game)
+                           return false;
+
+                       // A virtual gamepad goes through the same SDL events as a real one, so no hardware is needed
+                       int device = SDL_JoystickAttachVirtual(SDL_JOYSTICK_TYPE_GAMECONTROLLER, SDL_CONTROLLER_AXIS_MAX, SDL_CONTROLLER_BUTTON_MAX, 0);
+                       SDL_Joystick *joystick = device >= 0 ? SDL_JoystickOpen(device) : nullptr;
+                       if (!joystick)
+                       {
+                           std::cerr << "Failed to attach a virtual gamepad: " << SDL_GetError() << std::endl;
+                           EndGame(game);
+                           return false;
+                       }
+                       game->SetInputMapping("jump", {KEY_SPACE, PAD_A});
+                       game->SetInputMapping("right", {KEY_RIGHT, PAD_LEFT_STICK_RIGHT});
+                       // Let the game open the gamepad from its hot-plug event
+                       game->Step();
+
+                       // Callbacks fire for the keyboard and for gamepads
+                       int keyCalls = 0, padCalls = 0;
+                       game->SetActionCallback("jump", [&](ActionId action, int player, const InputEvent &event)
+                                               {
+                                                   if (event.down)
+                                                       (event.player < 0 ? keyCalls : padCalls)++; });
+                       SDL_Event key = {0};
+                       key.type = SDL_KEYDOWN;
+                       key.key.keysym.scancode = SDL_SCANCODE_SPACE;
+                       key.key.timestamp = SDL_GetTicks();
+                       SDL_PushEvent(&key);
+                       SDL_JoystickSetVirtualButton(joystick, SDL_CONTROLLER_BUTTON_A, 1);
+                       game->Step();
+                       suite.Check("gamepad_virtual: key callback", keyCalls == 1);
+                       suite.Check("gamepad_virtual: gamepad callback", padCalls == 1);
+
+                       key.type = SDL_KEYUP;
+                       SDL_PushEvent(&key);
+                       SDL_JoystickSetVirtualButton(joystick, SDL_CONTROLLER_BUTTON_A, 0);
+                       game->Step();
+                       game->SetActionCallback("jump", nullptr);
+
+                       // Presses and releases follow the button
+                       SDL_JoystickSetVirtualButton(joystick, SDL_CONTROLLER_BUTTON_A, 1);
+                       game->Step();
+                       suite.Check("gamepad_virtual: button pressed", game->InputPressed("jump") && !game->InputReleased("jump"));
+                       game->Step();
+                       suite.Check("gamepad_virtual: button held", !game->InputPressed("jump") && game->Input("jump") > 0.0f);
+                       SDL_JoystickSetVirtualButton(joystick, SDL_CONTROLLER_BUTTON_A, 0);
+                       game->Step();
+                       suite.Check("gamepad_virtual: button released", !game->InputPressed("jump") && game->InputReleased("jump"));
+
+                       // Analog values start past the dead zone and follow the stick from there
+                       float deadZone = game->GetOptions().gamepadDeadZone;
+                       SDL_JoystickSetVirtualAxis(joystick, SDL_CONTROLLER_AXIS_LEFTX, (Sint16)(deadZone * 0.5f * 32767));
+                       game->Step();
+                       suite.Check("gamepad_virtual: axis inside dead zone", game->InputValue("right") == 0.0f && !game->InputPressed("right"));
+                       float raw = (deadZone + 1.0f) * 0.5f;
+                       SDL_JoystickSetVirtualAxis(joystick, SDL_CONTROLLER_AXIS_LEFTX, (Sint16)(raw * 32767));
+                       game->Step();
+                       suite.Check("gamepad_virtual: axis past dead zone", NearZero(game->InputValue("right") - 0.5f, 0.01f) && game->InputPressed("right"));
+                       SDL_JoystickSetVirtualAxis(joystick, SDL_CONTROLLER_AXIS_LEFTX, 32767);
+                       game->Step();
+                       suite.Check("gamepad_virtual: axis fully pushed", NearZero(game->InputValue("right") - 1.0f, 0.01f));
+                       SDL_JoystickSetVirtualAxis(joystick, SDL_CONTROLLER_AXIS_LEFTX, 0);
+                       game->Step();
+                       suite.Check("gamepad_virtual: axis let go", game->InputValue("right") == 0.0f && game->InputReleased("right"));
+
+                       timer.Start();
+                       for (int i = 0; i < 600; i++)
+                       {
+                           SDL_JoystickSetVirtualButton(joystick, SDL_CONTROLLER_BUTTON_A, i % 2);
+                           SDL_JoystickSetVirtualAxis(joystick, SDL_CONTROLLER_AXIS_LEFTX, (Sint16)((i * 997) % 65536 - 32768));
+                           game->Step();
+                           suite.Consume(game->InputValue("right") + game->InputPressed("jump"));
+                       }
+                       timer.Stop();
+
+                       suite.Check("gamepad_virtual: connected", game->GetGamepad(0) != nullptr);
+                       SDL_JoystickClose(joystick);
+                       SDL_JoystickDetachVirtual(device);
+                       EndGame(game);
+                       return true; });
+}
+
+int main(int argc, char *argv[])
+{
+    std::string outPath = "bench_results.json", filter;
+    int samples = 5;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc)
+            outPath = argv[++i];
+        else if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (arg == "--samples" && i + 1 < argc)
+            samples = std::atoi(argv[++i]);
+        else
+        {
+            std::cerr << "Usage: junebug_bench [--out results.json] [--filter name] [--samples count]" << std::endl;
+            return 1;
+        }
+    }
+
+    Suite suite(samples, filter);
+    RunMicro(suite);
+    RunScenarios(suite);
+
+    if (outPath == "-")
+        suite.WriteJson(std::cout);
+    else
+    {
+        std::ofstream file(outPath);
+        suite.WriteJson(file);
+        if (!file)
+        {
+            std::cerr << "Failed to write " << outPath << std::endl;
+            return 1;
+        }
+        std::cerr << "Wrote " << suite.GetResults().size() << " results to " << outPath << std::endl;
+    }
+    if (suite.Failures() > 0)
+    {
+        std::cerr << suite.Failures() << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
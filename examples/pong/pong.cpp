@@ -66,7 +66,7 @@ public:
 
     void Update(float dt)
     {
-        MovePosition(Vec2(0.0f, InputsDir("up", "down", mPlayer) * 200 * dt));
+        MovePosition(Vec2(0.0f, InputsAxis("up", "down", mPlayer) * 200 * dt));
         ClampPosition(GetActorSize() / 2, Vec2<float>(Game::Get()->GetSceneSize()) - GetActorSize() / 2);
     }
 
@@ -96,11 +96,12 @@ public:
         new Wall(Vec2<float>(GetScreenWidth() / 2, -16.0f));
         new Wall(Vec2<float>(GetScreenWidth() / 2, GetScreenHeight() + 16.0f));
 
-        SetInputMapping("up", {KEY_W});
-        SetInputMapping("down", {KEY_S});
+        // Each player can also use their own gamepad
+        SetInputMapping("up", {KEY_W, PAD_DPAD_UP, PAD_LEFT_STICK_UP});
+        SetInputMapping("down", {KEY_S, PAD_DPAD_DOWN, PAD_LEFT_STICK_DOWN});
 
-        SetInputMapping("up", {KEY_UP}, 1);
-        SetInputMapping("down", {KEY_DOWN}, 1);
+        SetInputMapping("up", {KEY_UP, PAD_DPAD_UP, PAD_LEFT_STICK_UP}, 1);
+        SetInputMapping("down", {KEY_DOWN, PAD_DPAD_DOWN, PAD_LEFT_STICK_DOWN}, 1);
     }
 };
 
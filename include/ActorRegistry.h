@@ -0,0 +1,217 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include "Pool.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace junebug
+{
+    class Actor;
+
+    // A type list handed out by ActorRegistry::Get()
+    // The registry holds every list still while one of these exists, so the list can be iterated while actors are created and destroyed
+    // Actors created in the meantime are added once the last one is gone, and actors destroyed in the meantime are left as nullptrs until then
+    template <typename T>
+    class ActorList
+    {
+    public:
+        typedef typename std::vector<T *>::const_iterator const_iterator;
+
+        ActorList(const std::vector<T *> &actors, int &holds) : mActors(&actors), mHolds(&holds) { (*mHolds)++; }
+        ActorList(const ActorList &other) : ActorList(*other.mActors, *other.mHolds) {}
+        ActorList &operator=(const ActorList &) = delete;
+        ~ActorList() { (*mHolds)--; }
+
+        const_iterator begin() const { return mActors->begin(); }
+        const_iterator end() const { return mActors->end(); }
+        size_t size() const { return mActors->size(); }
+        bool empty() const { return mActors->empty(); }
+        T *operator[](size_t index) const { return (*mActors)[index]; }
+
+    private:
+        const std::vector<T *> *mActors;
+        int *mHolds;
+    };
+
+    // Where an actor is stored in one of the registry's type lists
+    struct ActorRegistrySlot
+    {
+        uint32_t list;
+        uint32_t index;
+    };
+
+    // Indexes actors by type and by id, so they can be found without checking every actor
+    // An actor's full type isn't known until its constructor finishes, so new actors wait in a pending list until the next type query
+    // A type's list is built the first time it's queried and kept up to date from then on
+    // While a list handed out by Get() exists, no list is added to or compacted, so it can be iterated while actors are created and destroyed
+    class ActorRegistry
+    {
+    public:
+        ActorRegistry() = default;
+        ActorRegistry(const ActorRegistry &) = delete;
+        ActorRegistry &operator=(const ActorRegistry &) = delete;
+
+        // Start tracking a newly constructed actor
+        void Add(Actor *actor);
+        // Stop tracking an actor
+        void Remove(Actor *actor);
+        // Change an actor's id
+        void SetId(Actor *actor, const std::string &id);
+
+
+        // Get every actor of type T, including types derived from it
+        /// @param allActors The game's actor list, used to build the list the first time T is queried
+        /// @returns The list of actors, in the order they were registered
+        template <typename T>
+        ActorList<T> Get(const std::vector<Actor *> &allActors)
+        {
+            bool held = mHolds > 0;
+            if (!held)
+                Flush();
+
+            TypedList<T> *list;
+            auto it = mListIds.find(std::type_index(typeid(T)));
+            if (it == mListIds.end())
+            {
+                uint32_t id = (uint32_t)mLists.size();
+                list = new TypedList<T>(id);
+                mLists.emplace_back(list);
+                mListIds[std::type_index(typeid(T))] = id;
+                // Pending actors are added when they're flushed
+                for (Actor *actor : allActors)
+                {
+                    if (actor && !IsPending(actor))
+                        list->TryAdd(actor);
+                }
+            }
+            else
+                list = static_cast<TypedList<T> *>(mLists[it->second].get());
+
+            if (!held)
+                list->Compact();
+            return ActorList<T>(list->actors, mHolds);
+        }
+
+        // Call a function on every actor of type T that's waiting to be added to the type lists
+        // Actors only wait while a list is held, so this catches the ones a held list is missing
+        template <typename T, typename F>
+        void ForEachPending(F &&func)
+        {
+            // Indexed, since the function may create more actors
+            for (size_t i = 0; i < mPending.size(); i++)
+            {
+                T *cast = mPending[i] ? dynamic_cast<T *>(mPending[i]) : nullptr;
+                if (cast)
+                    func(cast);
+            }
+        }
+
+        // Get the first actor of type T with an id
+        /// @returns A pointer to the actor or nullptr if no actor matches
+        template <typename T>
+        T *Find(const std::string &id) const
+        {
+            auto range = mIds.equal_range(id);
+            for (auto it = range.first; it != range.second; it++)
+            {
+                T *cast = dynamic_cast<T *>(it->second);
+                if (cast)
+                    return cast;
+            }
+            return nullptr;
+        }
+
+    private:
+        struct List
+        {
+            List(uint32_t id) : id(id) {}
+            virtual ~List() = default;
+
+            // Add the actor if it's the list's type
+            virtual void TryAdd(Actor *actor) = 0;
+            // Blank out the entry at an index, to be removed by the next Compact()
+            virtual void Clear(uint32_t index) = 0;
+            // Close any blank entries
+            virtual void Compact() = 0;
+
+            uint32_t id;
+            size_t holes = 0;
+        };
+
+        template <typename T>
+        struct TypedList : List
+        {
+            TypedList(uint32_t id) : List(id) {}
+
+            void TryAdd(Actor *actor) override
+            {
+                T *cast = dynamic_cast<T *>(actor);
+                if (!cast)
+                    return;
+                AddSlot(actor, id, (uint32_t)actors.size());
+                actors.push_back(cast);
+                owners.push_back(actor);
+            }
+
+            void Clear(uint32_t index) override
+            {
+                actors[index] = nullptr;
+                owners[index] = nullptr;
+                holes++;
+            }
+
+            void Compact() override
+            {
+                if (holes == 0)
+                    return;
+
+                size_t kept = 0;
+                for (size_t i = 0; i < actors.size(); i++)
+                {
+                    if (!owners[i])
+                        continue;
+                    if (kept != i)
+                    {
+                        actors[kept] = actors[i];
+                        owners[kept] = owners[i];
+                        MoveSlot(owners[kept], id, (uint32_t)kept);
+                    }
+                    kept++;
+                }
+                actors.resize(kept);
+                owners.resize(kept);
+                holes = 0;
+            }
+
+            std::vector<T *> actors;
+            // The same actors as Actor pointers, since T doesn't have to derive from Actor
+            std::vector<Actor *> owners;
+        };
+
+        // Sort pending actors into the type lists
+        void Flush();
+
+        static bool IsPending(Actor *actor);
+        static void AddSlot(Actor *actor, uint32_t list, uint32_t index);
+        static void MoveSlot(Actor *actor, uint32_t list, uint32_t index);
+
+        std::vector<std::unique_ptr<List>> mLists;
+        std::unordered_map<std::type_index, uint32_t> mListIds;
+        // Actors that haven't been sorted into type lists yet
+        // Removed actors are blanked out, since the list is only walked by Flush()
+        std::vector<Actor *> mPending;
+        // Id entries come from the pools, since actors with ids come and go constantly
+        std::unordered_multimap<std::string, Actor *, std::hash<std::string>, std::equal_to<std::string>, PoolAllocator<std::pair<const std::string, Actor *>>> mIds;
+        // The number of lists handed out that still exist
+        int mHolds = 0;
+    };
+}
\ No newline at end of file
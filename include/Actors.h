@@ -8,6 +8,7 @@
 #include "Color.h"
 #include "Sprite.h"
 #include "components/Collider.h"
+#include "Pool.h"
 
 #include <functional>
 #include <vector>
@@ -43,6 +44,10 @@ namespace junebug
         // Default destructor
         virtual ~Actor();
 
+        // Actors come from pools grouped by size, so spawning and destroying them doesn't go through the heap
+        static void *operator new(size_t size) { return Pool::Allocate(size); }
+        static void operator delete(void *ptr, size_t size) { Pool::Free(ptr, size); }
+
         // ToString
         virtual void ToString(std::ostream &out) const
         {
@@ -63,9 +68,8 @@ namespace junebug
         template <typename T = Actor>
         static void SetAllState(ActorState state)
         {
-            auto actors = Game::Get()->GetActors<T>();
-            for (auto actor : actors)
-                actor->SetState(state);
+            Game::Get()->ForEachActor<T>([state](T *actor)
+                                         { actor->SetState(state); });
         }
 
         // Mark the actor as paused. This will prevent it from being updated.
@@ -93,13 +97,12 @@ namespace junebug
         template <typename T = Actor>
         static void SetAllPersistent(bool persistent)
         {
-            auto actors = Game::Get()->GetActors<T>();
-            for (auto actor : actors)
-                actor->SetPersistent(persistent);
+            Game::Get()->ForEachActor<T>([persistent](T *actor)
+                                         { actor->SetPersistent(persistent); });
         }
 
         // Vector of attached components
-        std::vector<class Component<Actor> *> mComponents;
+        std::vector<class Component<Actor> *, PoolAllocator<class Component<Actor> *>> mComponents;
         // Returns component of type T, or null if doesn't exist
         template <typename T>
         T *GetComponent() const
@@ -121,12 +124,14 @@ namespace junebug
         static T *__createInstance__() { return new T(); };
 
         // Set the actor's depth
-        void SetDepth(int newDepth) { mDepth = newDepth; };
+        void SetDepth(int newDepth);
         // Get the actor's depth
         int GetDepth() { return mDepth; };
 
         // Get the actor's id
-        std::string GetId() const { return mId; }
+        const std::string &GetId() const { return mId; }
+        // Set the actor's id
+        void SetId(std::string id);
 
         // Add a component to the actor
         void AddComponent(class Component<> *c);
@@ -135,10 +140,16 @@ namespace junebug
         friend class Component<>;
         friend class Game;
         friend class Camera;
+        friend class ActorRegistry;
 
         // User-defined function to run every frame when the actor draws
         virtual void Draw(){};
 
+        // Internal function to run every update before components update
+        virtual void InternalPreUpdate(float dt){};
+        // Internal function to run every frame before the actor updates
+        // May run on a worker thread at the same time as other actors' parallel updates, so it must only touch this actor
+        virtual void InternalParallelUpdate(float dt){};
         // User-defined function to every frame when the actor updates
         virtual void InternalUpdate(float dt){};
         virtual void Update(float dt){};
@@ -157,6 +168,16 @@ namespace junebug
 
         // Actor ID
         std::string mId;
+
+        // Whether the actor is still in the game's actor list
+        bool mInActorList = false;
+        // When the actor was added to the game, relative to other actors
+        uint64_t mSpawnOrder = 0;
+
+        // Where the actor is stored in the game's actor registry
+        std::vector<ActorRegistrySlot, PoolAllocator<ActorRegistrySlot>> mRegistrySlots;
+        // The actor's place in the registry's pending list, or -1 once it's been sorted into type lists
+        int mRegistryPending = -1;
     };
 
     /// @brief A VisualActor is an actor that has a visual representation, including a texture, position, rotation, scale, and color.
@@ -185,6 +206,8 @@ namespace junebug
         VisualActor(Vec2<int> pos, std::string imagePath);
 
         void InternalFirstUpdate(float dt) override;
+        void InternalPreUpdate(float dt) override;
+        void InternalParallelUpdate(float dt) override;
         void InternalUpdate(float dt) override;
 
         // Actor visibility
@@ -213,6 +236,8 @@ namespace junebug
         class Sprite *GetSprite();
         // Get the sprite of the actor
         class Sprite *GetRawSprite();
+        // Get the handle of the actor's sprite, resolved when the sprite was set
+        SpriteHandle GetSpriteHandle() const { return mSpriteHandle; }
 
         static Sprite __tempSprite__;
 
@@ -245,7 +270,12 @@ namespace junebug
         /// @returns const Vec2
         Vec2<float> GetStartPosition() const;
         // Get the previous position of the actor
+        // This is the position at the start of the current update
         Vec2<float> GetPrevPosition() const;
+        // Get the position the actor should be drawn at
+        // With fixed updates, this blends between the previous and current position
+        /// @returns const Vec2
+        Vec2<float> GetInterpolatedPosition() const;
         // Clamp the actor's position to the given bounds
         /// @param bounds The bounds to clamp the actor to
         void ClampPosition(const Vec2<float> &start, const Vec2<float> &end);
@@ -305,6 +335,7 @@ namespace junebug
         virtual void Draw() override;
 
         std::string mSpritePath;
+        SpriteHandle mSpriteHandle;
         bool mVisible{true};
         Color mColor = Color::White;
 
@@ -0,0 +1,94 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include "SDL2/SDL.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace junebug
+{
+    // Progress of a group of preloaded assets
+    struct LoadProgress
+    {
+        int total = 0;
+        int loaded = 0;
+
+        // Get the fraction of the group that has finished loading, from 0 to 1
+        float Fraction() const { return total > 0 ? (float)loaded / total : 1.0f; }
+        bool Done() const { return loaded >= total; }
+    };
+
+    // Loads sprites in the background
+    // Worker threads read metadata and decode images into surfaces, then Pump() uploads them to textures on the main thread
+    // Without worker threads, Pump() does the whole load itself, spread across frames
+    class AssetLoader
+    {
+    public:
+        ~AssetLoader();
+
+        // Start the worker threads
+        /// @param threadCount The number of workers; 0 loads everything on the main thread
+        void Start(int threadCount);
+        // Stop the worker threads and discard any unfinished loads
+        void Stop();
+
+        // Queue a sprite to be loaded
+        // Sprites that are already loaded or queued are ignored
+        /// @param path The full path to the sprite's image or folder
+        /// @param group The group to count the sprite towards
+        void PreloadSprite(const std::string &path, const std::string &group = "");
+
+        // Upload finished loads to the game
+        /// @param budget The maximum time to spend, in milliseconds; at least one load is always finished
+        void Pump(float budget);
+        // Block until every sprite in a group has been loaded
+        /// @param group The group to finish, or "" for every group
+        void Finish(const std::string &group = "");
+
+        // Get the progress of a group
+        /// @param group The group to check, or "" for every queued sprite
+        LoadProgress GetProgress(const std::string &group = "") const;
+        // Whether any sprite in a group is still loading
+        bool IsLoading(const std::string &group = "") const { return !GetProgress(group).Done(); }
+
+    private:
+        struct Job
+        {
+            std::string path, group;
+
+            bool isFolder = false;
+            std::unique_ptr<class Json> metadata;
+            // Decoded frames and the file names they were loaded from
+            std::vector<std::pair<std::string, SDL_Surface *>> surfaces;
+            bool decoded = false;
+        };
+
+        std::vector<std::thread> mWorkers;
+        mutable std::mutex mMutex;
+        std::condition_variable mJobReady, mJobDone;
+        bool mStopping = false;
+
+        // Jobs waiting for a worker, and jobs waiting to be uploaded
+        std::deque<std::unique_ptr<Job>> mPending, mDecoded;
+        int mInFlight = 0;
+
+        // Only touched on the main thread
+        std::unordered_set<std::string> mQueued;
+        std::unordered_map<std::string, LoadProgress> mGroups;
+        LoadProgress mTotal;
+
+        void WorkerLoop();
+        static void Decode(Job &job);
+        void Upload(Job &job);
+        static void FreeSurfaces(Job &job);
+    };
+}
\ No newline at end of file
@@ -4,9 +4,40 @@
 #endif
 
 #include <SDL2/SDL_stdinc.h>
+#include "Pool.h"
+
+#include <cstdint>
 
 namespace junebug
 {
+    class ComponentPass;
+    // Internal function to take a destroyed component out of its pass
+    void __RemoveFromComponentPass__(ComponentPass *pass, uint32_t index);
+
+    // Parts of the game an update can touch, combined into read and write sets
+    enum UpdateAccessFlags : Uint32
+    {
+        ACCESS_NONE = 0,
+        // The component itself and its owning actor
+        ACCESS_OWNER = 1 << 0,
+        // Other actors and their components
+        ACCESS_ACTORS = 1 << 1,
+        // The game, including collisions, cameras, scenes, sprites and inputs
+        ACCESS_GAME = 1 << 2,
+        ACCESS_ALL = ACCESS_OWNER | ACCESS_ACTORS | ACCESS_GAME
+    };
+
+    // What an update reads and writes
+    struct UpdateAccess
+    {
+        Uint32 reads, writes;
+
+        // Whether updates of different components can run at the same time
+        // True when each update only writes its own component and actor, and doesn't read other actors
+        constexpr bool IsParallel() const { return (writes & ~ACCESS_OWNER) == 0 && (reads & ACCESS_ACTORS) == 0; }
+        constexpr bool IsEmpty() const { return reads == ACCESS_NONE && writes == ACCESS_NONE; }
+    };
+
     // CRTP base class for singletons
     template <typename T = class Actor>
     class Component
@@ -18,17 +49,43 @@ namespace junebug
             mOwner->AddComponent((Component<class Actor> *)this);
         }
         // Destructor
-        virtual ~Component(){};
+        virtual ~Component()
+        {
+            if (mPass)
+                __RemoveFromComponentPass__(mPass, mPassIndex);
+        };
+
+        // Components come from the same pools as actors
+        static void *operator new(size_t size) { return Pool::Allocate(size); }
+        static void operator delete(void *ptr, size_t size) { Pool::Free(ptr, size); }
         // Update this component by delta time
         virtual void Update(float dt){};
 
+        // What Update() reads and writes
+        // Component types can redeclare this; if the access is parallel, the type's pass spreads its updates across the game's worker threads
+        static constexpr UpdateAccess kUpdateAccess{ACCESS_ALL, ACCESS_ALL};
+        // What PrepareUpdate() reads and writes
+        // Component types that redeclare this get PrepareUpdate() called on every component in their pass before any of their Update()s
+        static constexpr UpdateAccess kPrepareAccess{ACCESS_NONE, ACCESS_NONE};
+        // The first half of an update, for work that can be split from the part that touches the game
+        // Only called by component passes
+        void PrepareUpdate(float dt){};
+
         // Return the update order of this component
         int GetUpdateOrder() const { return mUpdateOrder; }
+        // Whether this component is updated by a component pass instead of by its actor
+        bool InComponentPass() const { return mPass != nullptr; }
 
     protected:
+        friend class ComponentPass;
+
         // Owning actor
         T *mOwner;
         // Update order
         int mUpdateOrder;
+
+        // The pass this component is updated in, if it was made with Game::CreateComponent()
+        ComponentPass *mPass = nullptr;
+        uint32_t mPassIndex = 0;
     };
 }
\ No newline at end of file
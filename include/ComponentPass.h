@@ -0,0 +1,96 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include "Component.h"
+#include "JobSystem.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace junebug
+{
+    // Every component of one type and update order, updated together in a single loop
+    // Components made with Game::CreateComponent() are put in a pass when GameOptions::componentPasses is on
+    // Removed components leave a gap that's closed at the start of the next update, so components can be removed mid-pass
+    // Updates declared parallel by the component type are spread across the game's worker threads
+    class ComponentPass
+    {
+    public:
+        ComponentPass(int updateOrder, JobSystem &jobs) : mUpdateOrder(updateOrder), mJobs(jobs) {}
+        virtual ~ComponentPass();
+
+        // Update every component whose actor is active
+        virtual void Update(float dt) = 0;
+
+        // Remove the component at an index
+        void Remove(uint32_t index);
+
+        int GetUpdateOrder() const { return mUpdateOrder; }
+        // Get the number of components in the pass
+        size_t GetCount() const { return mComponents.size() - mHoles; }
+
+    protected:
+        void Add(Component<> *comp);
+        // Close the gaps left by removed components
+        void Compact();
+        // Whether a component's actor is active
+        static bool IsActive(Component<> *comp);
+
+        int mUpdateOrder;
+        JobSystem &mJobs;
+        std::vector<Component<> *> mComponents;
+        size_t mHoles = 0;
+        // Whether an actor has more than one component in the pass, in which case their updates would share a write set
+        bool mSharedOwners = false;
+    };
+
+    template <typename T>
+    class TypedComponentPass : public ComponentPass
+    {
+    public:
+        TypedComponentPass(int updateOrder, JobSystem &jobs) : ComponentPass(updateOrder, jobs) {}
+
+        void Add(T *comp) { ComponentPass::Add((Component<> *)comp); }
+
+        void Update(float dt) override
+        {
+            Compact();
+
+            // Components added during the pass wait until the next frame, like new actors
+            // Every component is exactly a T, so updates are called directly instead of through the vtable
+            size_t count = mComponents.size();
+            if (!T::kPrepareAccess.IsEmpty())
+            {
+                Run(count, T::kPrepareAccess.IsParallel(), [dt](T *comp)
+                    { comp->T::PrepareUpdate(dt); });
+            }
+            Run(count, T::kUpdateAccess.IsParallel(), [dt](T *comp)
+                { comp->T::Update(dt); });
+        }
+
+    private:
+        // The number of components each worker takes at a time
+        static const size_t kBatchSize = 64;
+
+        template <typename F>
+        void Run(size_t count, bool parallel, const F &func)
+        {
+            auto batch = [this, &func](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    Component<> *comp = mComponents[i];
+                    if (comp && IsActive(comp))
+                        func((T *)comp);
+                }
+            };
+
+            if (parallel && !mSharedOwners)
+                mJobs.ParallelFor(count, kBatchSize, batch);
+            else
+                batch(0, count);
+        }
+    };
+}
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <string>
 #include <fstream>
 #include <vector>
+#include <algorithm>
 
 using namespace rapidjson;
 
@@ -389,6 +390,49 @@ namespace junebug
             return def;
         }
 
+        // Read a 2D array of numbers into a flat, row-major vector
+        // Rows shorter than the longest row are padded with the fill value
+        /// @param width Set to the length of the longest row
+        /// @param height Set to the number of rows
+        template <typename T>
+        static std::vector<T> GetNumberGrid(const Value &val, int &width, int &height, T fill = T())
+        {
+            std::vector<T> res;
+            width = height = 0;
+            if (!val.IsArray())
+                return res;
+
+            for (auto &row : val.GetArray())
+            {
+                if (row.IsArray())
+                    width = std::max(width, (int)row.Size());
+            }
+            height = (int)val.Size();
+
+            res.assign((size_t)width * height, fill);
+            int y = 0;
+            for (auto &row : val.GetArray())
+            {
+                if (row.IsArray())
+                {
+                    int x = 0;
+                    for (auto &v : row.GetArray())
+                        res[(size_t)y * width + x++] = GetNumber<T>(v);
+                }
+                y++;
+            }
+
+            return res;
+        }
+        template <typename T>
+        static std::vector<T> GetNumberGrid(const GenericObject<false, Value> &obj, std::string key, int &width, int &height, T fill = T())
+        {
+            if (obj.HasMember(key.c_str()))
+                return GetNumberGrid(obj[key.c_str()], width, height, fill);
+            width = height = 0;
+            return std::vector<T>();
+        }
+
         static std::vector<std::string> GetStringArray(const Value &val, std::vector<std::string> def = std::vector<std::string>())
         {
             std::vector<std::string> res;
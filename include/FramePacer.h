@@ -0,0 +1,79 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include <chrono>
+#include <vector>
+
+namespace junebug
+{
+    // Timing information about recent frames
+    // All times are in seconds
+    struct FrameStats
+    {
+        // The length of the last frame
+        float frameTime = 0.0f;
+        // The time the last frame spent working before it started waiting
+        float workTime = 0.0f;
+        // Frame length statistics over the last few seconds of frames
+        float averageFrameTime = 0.0f, minFrameTime = 0.0f, maxFrameTime = 0.0f;
+        // The current estimate of how long the OS oversleeps by
+        float oversleep = 0.0f;
+        // The number of frames in the last full second
+        unsigned int fps = 0;
+    };
+
+    // Waits until the start of the next frame using a monotonic clock
+    // Most of the wait is spent asleep in shrinking slices; only the last moment before the deadline is spun
+    // The OS's wake-up delay is measured as the game runs, so the spin stays as short as the platform allows
+    class FramePacer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        FramePacer();
+
+        // Start timing from the current moment
+        void Reset();
+
+        // Set the target framerate
+        /// @param fps The number of frames per second
+        void SetTargetFps(double fps);
+        // Set whether the pacer is allowed to sleep, rather than spinning for the whole wait
+        void SetSleepEnabled(bool sleep) { mSleepEnabled = sleep; }
+        // Set the starting guess for how long the OS oversleeps by
+        /// @param ms The oversleep in milliseconds
+        void SetOversleepEstimate(double ms);
+
+        // Block until the next frame should start
+        /// @returns The time since the previous frame started, in seconds
+        float Wait();
+
+        // Get timing information about recent frames
+        const FrameStats &GetStats() const { return mStats; }
+
+    private:
+        // Frames of history kept for the statistics
+        static const int kHistorySize = 240;
+
+        Clock::duration mTarget;
+        Clock::time_point mFrameStart, mNextFrame, mSecondStart;
+        bool mSleepEnabled = true;
+
+        // Running mean and variance of the measured oversleep, in seconds
+        double mOversleepMean = 0.001, mOversleepVar = 0.0;
+
+        std::vector<float> mHistory;
+        int mHistoryIndex = 0;
+        unsigned int mFramesThisSecond = 0;
+
+        FrameStats mStats;
+
+        // The time to stop sleeping before the deadline
+        double GetSleepMargin() const;
+        void SleepUntil(Clock::time_point deadline);
+        void AddOversleepSample(double sample);
+        void UpdateStats(float frameTime, float workTime, Clock::time_point now);
+    };
+}
\ No newline at end of file
@@ -9,11 +9,22 @@
 
 #include "Utils.h"
 #include "Twerp.h"
+#include "TwerpEngine.h"
 #include "MathLib.h"
 #include "RandLib.h"
 #include "Inputs.h"
 #include "Color.h"
 #include "Files.h"
+#include "SpatialHash.h"
+#include "RenderQueue.h"
+#include "Rendering.h"
+#include "TextureAtlas.h"
+#include "AssetLoader.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include "ActorRegistry.h"
+#include "ComponentPass.h"
+#include "JobSystem.h"
 
 #include "SDL2/SDL.h"
 #include "SDL2/SDL_mixer.h"
@@ -26,6 +37,7 @@
 #include <queue>
 #include <chrono>
 #include <memory>
+#include <map>
 
 using namespace std::chrono;
 using dsec = duration<double>;
@@ -88,9 +100,19 @@ namespace junebug
         float quitCloseTime = 0.0f;
         // Whether the game should toggle fullscreen after the F11 key
         bool fullscreenOnF11 = true;
+        // Whether gamepads are read
+        // Each connected gamepad is given to the first player without one
+        bool gamepads = true;
+        // How far a stick or trigger has to move, from 0 to 1, before it counts as held
+        // Analog values are rescaled to start from 0 at the edge of the dead zone
+        float gamepadDeadZone = 0.2f;
 
         // The name of the starting scene
         std::string startingScene;
+        // Whether the game should run without a window, renderer, or audio
+        // Frames aren't drawn or paced, so updates run as fast as possible with a constant delta time
+        // Inputs can be driven with Game::SetInputState()
+        bool headless = false;
         // Whether the game should automatically create a camera
         bool createDefaultCamera = true;
         // The default camera's size
@@ -100,27 +122,82 @@ namespace junebug
 
         // Whether the game should render the colliders of all actors
         bool drawColliders = false;
+        // Whether sprite draws should be queued and submitted in batches
+        // Sprites that share a texture are grouped, but only past sprites they don't overlap, so the result looks the same
+        // Custom Draw() functions that call SDL directly should call Game::FlushRenderQueue() first
+        bool batchSprites = true;
+        // Whether sprite frames should be packed into shared atlas pages as they're loaded
+        // Frames that share a page can be batched into a single draw call
+        bool textureAtlas = true;
+        // The width and height of each atlas page, clamped to the renderer's texture size limit
+        int atlasPageSize = 2048;
+        // Folder to cache packed atlas pages in between runs
+        // Leave empty to pack every time the game starts
+        std::string atlasCachePath = "";
+        // The number of threads that decode preloaded sprites in the background
+        // With 0 threads, preloads are still spread across frames but decoded on the main thread
+        int assetLoaderThreads = 2;
+        // The maximum number of milliseconds per frame to spend uploading preloaded sprites
+        float assetUploadBudget = 4.0f;
+        // Whether components made with CreateComponent() are updated in per-type passes
+        // Each pass updates every component of one type and update order, after every actor's first update and before their main updates
+        bool componentPasses = false;
+        // The number of worker threads used to update component passes and actors in parallel
+        // 0 runs everything on the main thread; -1 uses every core but one
+        // With workers, every actor's first update runs before any actor's main update, as with componentPasses
+        int workerThreads = 0;
+        // The size of each cell in the collision broadphase grid
+        // Should be around the size of a typical moving collider
+        float collisionCellSize = 64.0f;
 
         // The game's target framerate
         int fpsTarget = 60;
         // Whether the game should automatically target the display's refresh rate
         bool detectFps = true;
-        // Whether the game should block the main thread until the target framerate is reached
-        // True == Low CPU, occasional frame time spikes
-        // False == High CPU, consistent frame time
+        // Whether updates should run at a fixed rate, independent of the framerate
+        // Inputs are processed once per update, and actors are drawn between their last two updates
+        bool fixedTimestep = false;
+        // The number of fixed updates per second
+        // Only used if fixedTimestep is true
+        float fixedUpdateRate = 60.0f;
+        // The maximum number of fixed updates to run in a single frame
+        // Time beyond this is dropped, so the game slows down instead of falling further behind
+        // Only used if fixedTimestep is true
+        int maxFixedSteps = 5;
+        // Whether the game should sleep the main thread until the next frame
+        // True == Low CPU, only the last moment before each frame is spun
+        // False == High CPU, the whole wait is spun
         bool shouldThreadSleep = true;
-        // The number of milliseconds to under-sleep the main thread by
-        // This is to account for the fact that a sleeping thread will not wake up exactly when it is supposed to, and will likely overshoot the target time
-        // A higher value will result in more consistent frame times, but will also result in more CPU usage
+        // The initial guess, in milliseconds, for how late a sleeping thread wakes up
+        // The real value is measured while the game runs, so this only affects the first few frames
         // Only used if shouldThreadSleep is true
-        double sleepMargin = 9.;
+        double sleepMargin = 1.;
 
         // The game's random seed
+        // -1 picks a seed from the clock
         int randomSeed = -1;
+        // Record every input to this file from the moment the game starts
+        // Leave empty to not record
+        std::string recordInputPath = "";
+        // Play back a recording from this file in place of device input, from the moment the game starts
+        // Leave empty to use device input
+        std::string replayInputPath = "";
+        // Whether replays run as fast as possible instead of waiting between frames
+        bool replayFullSpeed = true;
+        // Whether the game quits when a replay finishes
+        // Otherwise, device input takes over
+        bool quitAfterReplay = false;
 
         // Whether the game should print the defaults debug info to the console
         // These allow for easy debugging of the game's logic and render steps
         bool showDefaultDebugCheckpoints = true;
+        // Whether to record profiler zones in release builds
+        // Debug builds always record them
+        bool profiler = false;
+        // The number of frames the profiler's statistics are calculated over
+        int profilerWindow = 120;
+        // How often the debug info and profiler statistics are printed, in seconds
+        float debugPrintInterval = 0.25f;
     };
 
     struct Layer
@@ -147,7 +224,30 @@ namespace junebug
         }
     };
 
-    typedef std::pair<std::string, std::vector<Uint8>> input_mapping;
+    typedef std::pair<std::string, std::vector<InputCode>> input_mapping;
+
+    // An index into the game's table of input actions
+    // Checking an input by ID is an array read, so prefer IDs for inputs that are checked every frame
+    typedef int ActionId;
+    // An ID that no action has
+    const ActionId kNoAction = -1;
+
+    // A single press or release, in the order it came from the device
+    struct InputEvent
+    {
+        InputCode input;
+        bool down;
+        // When SDL received the event, in milliseconds since SDL started
+        Uint32 timestamp;
+        // The player whose gamepad sent the event, or -1 for the keyboard and mouse
+        int player;
+    };
+
+    // Called as soon as one of an action's inputs is pressed or released
+    /// @param action The action
+    /// @param player The player the action is mapped for
+    /// @param event The press or release
+    typedef std::function<void(ActionId action, int player, const InputEvent &event)> ActionCallback;
 
     /// @brief The Game class is the main class for the Junebug engine. It contains the game loop and handles all of the SDL2 initialization and shutdown.
     class Game
@@ -156,7 +256,7 @@ namespace junebug
         // Game constructor
         Game();
         // Game destructor
-        ~Game();
+        virtual ~Game();
         // Get the global game instance
         static Game *Get();
 
@@ -181,43 +281,126 @@ namespace junebug
 
         // Get the renderer
         SDL_Renderer *GetRenderer() { return mRenderer; }
+        // Get the sprite render queue
+        RenderQueue &GetRenderQueue() { return mRenderQueue; }
+        // Draw any queued sprites immediately
+        // Called automatically before any unbatched draw
+        void FlushRenderQueue()
+        {
+            if (mRenderer)
+                mRenderQueue.Flush(mRenderer);
+        }
+        // Get the number of times the renderer has lost the contents of its render targets
+        // Anything caching render target textures should rebuild them when this changes
+        unsigned int GetRenderTargetResets() const { return mRenderTargetResets; }
         // Get the window
         SDL_Window *GetWindow() { return mWindow; }
         // Raise window
         void RaiseWindow();
 
         // Get the FPS the game is currently running at
-        int GetFPS() { return mFps; }
+        int GetFPS() { return mFramePacer.GetStats().fps; }
+        // Get timing information about recent frames
+        const FrameStats &GetFrameStats() const { return mFramePacer.GetStats(); }
 
 #pragma region Input
         // Check a given input name
         /// @param key The name of the input to check
-        /// @returns number of frames the input has been held for
-        float Input(std::string key, int player = 0);
+        /// @returns number of seconds the input has been held for
+        float Input(const std::string &key, int player = 0);
+        float Input(ActionId action, int player = 0);
         // Check if a given input is pressed
         /// @param key The name of the input to check
         /// @returns true if the input was first pressed this frame, false otherwise
-        bool InputPressed(std::string key, int player = 0);
+        bool InputPressed(const std::string &key, int player = 0);
+        bool InputPressed(ActionId action, int player = 0);
+        // Check if a given input was released
+        /// @param key The name of the input to check
+        /// @returns true if the input was let go this frame, false otherwise
+        bool InputReleased(const std::string &key, int player = 0);
+        bool InputReleased(ActionId action, int player = 0);
         // Get the int result of two opposite inputs
         /// @param key1 The first input
         /// @param key2 The second input
-        int InputsDir(std::string negKey, std::string posKey, int player = 0);
+        int InputsDir(const std::string &negKey, const std::string &posKey, int player = 0);
+        int InputsDir(ActionId negAction, ActionId posAction, int player = 0);
         // Get the int result of two opposite inputs being pressed this frame
         /// @param key1 The first input
         /// @param key2 The second input
-        int InputsPressedDir(std::string negKey, std::string posKey, int player = 0);
+        int InputsPressedDir(const std::string &negKey, const std::string &posKey, int player = 0);
+        int InputsPressedDir(ActionId negAction, ActionId posAction, int player = 0);
+        // Check how far a given input is held down
+        /// @param key The name of the input to check
+        /// @returns 1 for held buttons and keys, how far a stick or trigger is pushed for analog inputs, or 0 if it's not held
+        float InputValue(const std::string &key, int player = 0);
+        float InputValue(ActionId action, int player = 0);
+        // Get the analog result of two opposite inputs, such as the two directions of a stick
+        /// @param negKey The input for the negative direction
+        /// @param posKey The input for the positive direction
+        /// @returns A value from -1 to 1
+        float InputsAxis(const std::string &negKey, const std::string &posKey, int player = 0);
+        float InputsAxis(ActionId negAction, ActionId posAction, int player = 0);
+        // Get the ID of an input name, adding it to the action table if it's new
+        // IDs stay the same for the rest of the game
+        /// @param key The name of the input
+        /// @returns The input's ID
+        ActionId RegisterAction(const std::string &key);
+        // Get the ID of an input name
+        /// @param key The name of the input
+        /// @returns The input's ID, or kNoAction if it was never registered or mapped
+        ActionId GetActionId(const std::string &key) const;
         // Set the input mapping for a given input name
         /// @param key The name of the input
-        /// @param inputs A vector of SDL keycodes to map to the input
-        void SetInputMapping(std::string key, std::vector<Uint8> inputs, int player = 0);
+        /// @param inputs A vector of input codes to map to the input
+        /// @returns The input's ID
+        ActionId SetInputMapping(const std::string &key, std::vector<InputCode> inputs, int player = 0);
         // Set a list of input mappings
         /// @param inputMapping A list of input mappings, where the each element is a pair with the input name and a vector of SDL keycodes
         void SetInputMappings(
-            std::vector<std::pair<std::string, std::vector<Uint8>>> inputMappings, int player = 0);
+            std::vector<std::pair<std::string, std::vector<InputCode>>> inputMappings, int player = 0);
         // Get an input mapping if it exists
-        std::vector<Uint8> *GetInputMapping(std::string key, int player = 0);
+        std::vector<InputCode> *GetInputMapping(const std::string &key, int player = 0);
         // Check if an input mapping exists
-        bool InputExists(std::string key, Uint8 input, int player = 0);
+        bool InputExists(const std::string &key, InputCode input, int player = 0);
+        // Hold down or release an input from code, as if it came from a device
+        // Scripted inputs stay held until released, and are combined with real device input
+        // Scripted gamepad inputs are held for every player
+        /// @param input The input code to set
+        /// @param down Whether the input is held down
+        void SetInputState(InputCode input, bool down);
+        // Release every input held by SetInputState()
+        void ClearInputStates();
+        // Get every press and release since the previous update, in the order they happened
+        // Presses shorter than a frame still count for InputPressed(), and these events keep their order and timing
+        const std::vector<InputEvent> &GetInputEvents() const { return mInputEvents; }
+        // Call a function the moment an action's inputs are pressed or released, rather than waiting for the next update
+        // Callbacks run while events are polled, before any actor updates
+        /// @param action The action to watch
+        /// @param callback The function to call, or nullptr to stop watching
+        void SetActionCallback(ActionId action, ActionCallback callback);
+        void SetActionCallback(const std::string &key, ActionCallback callback);
+        // Record every device input from now on to a file
+        // The random generators are reseeded and the seed is saved with the inputs
+        // For a replay to match, recording has to start from the same game state, such as with GameOptions::recordInputPath
+        /// @param path The file to write to
+        /// @returns True if the file was opened
+        bool StartRecording(const std::string &path);
+        // Stop recording and close the file
+        void StopRecording();
+        // Whether inputs are being recorded
+        bool IsRecording() const { return mRecordFile != nullptr; }
+        // Play back a recording in place of device input
+        // Each update gets the recorded inputs, mouse position and frame length, so a deterministic game repeats the recorded session exactly
+        /// @param path The file to read from
+        /// @returns True if the file is a valid recording
+        bool StartReplay(const std::string &path);
+        // Stop playing back a recording and return to device input
+        void StopReplay();
+        // Whether a recording is being played back
+        bool IsReplaying() const { return mReplayFile != nullptr; }
+        // Get a player's gamepad, such as to make it rumble
+        /// @returns The gamepad, or nullptr if the player doesn't have one connected
+        SDL_GameController *GetGamepad(int player = 0);
         // Get the current mouse position
         /// @returns Vec2 with the mouse position in game coordinates, relative to a certain camera
         Vec2<int> GetMousePos();
@@ -245,6 +428,16 @@ namespace junebug
         /// @returns true if successful, false otherwise
         bool Run(int screenWidth = -1, int screenHeight = -1);
 
+        // Set up the game without starting the game loop
+        // Use this with Step() to drive the game manually, such as in headless simulations
+        /// @returns true if successful, false otherwise
+        bool Init(int screenWidth = -1, int screenHeight = -1);
+        // Run a number of frames immediately
+        // In headless mode, every frame advances by exactly 1 / fpsTarget seconds
+        /// @param frames The number of frames to run
+        /// @returns true if the game is still running
+        bool Step(unsigned int frames = 1);
+
         // Clean up any resources used by the game
         // Should be called after RunLoop() has finished and before the program exits
         void Shutdown();
@@ -264,11 +457,21 @@ namespace junebug
         virtual void RenderEnd(){};
 
         // Get the DeltaTime
+        // During fixed updates, this is the fixed update length
         float GetDeltaTime() { return mDeltaTime; }
+        // Get the length of a fixed update in seconds
+        float GetFixedDeltaTime() const { return 1.0f / Max(options.fixedUpdateRate, 1.0f); }
+        // Get how far the current frame is between the last two fixed updates
+        /// @returns A value from 0 to 1, or 1 if fixed updates are disabled
+        float GetInterpolationAlpha() const { return mInterpolationAlpha; }
 
         // Get the number of frames that have passed since the game started
         unsigned long GetFrameCount() { return mFrameCount; }
 
+        // Get the worker threads used for parallel updates
+        // Their ParallelFor() can also be used by game code on the main thread
+        JobSystem &GetJobSystem() { return mJobs; }
+
 #ifdef __EMSCRIPTEN__
         void EmRunIteration()
         {
@@ -280,11 +483,32 @@ namespace junebug
 
 #pragma region Sprites
         // Add a sprite to the cache
+        // Replacing a sprite keeps its handle, so existing handles see the new sprite
         /// @param name The name of the sprite
         /// @param sprite The sprite to add
-        void AddSprite(std::string name, std::shared_ptr<class Sprite> sprite);
-        // Get a const reference to the sprite cache
-        const std::unordered_map<std::string, std::shared_ptr<class Sprite>> &GetSpriteCache() { return mSpriteCache; }
+        /// @returns The sprite's handle
+        SpriteHandle AddSprite(std::string name, std::shared_ptr<class Sprite> sprite);
+        // Remove a sprite from the cache, invalidating every handle to it
+        /// @param name The name of the sprite
+        void RemoveSprite(const std::string &name);
+        // Find the handle of a sprite that's already in the cache
+        /// @param name The name of the sprite
+        /// @returns The sprite's handle, or an invalid handle if it hasn't been loaded
+        SpriteHandle FindSprite(const std::string &name) const;
+        // Get the sprite a handle refers to
+        /// @returns The sprite, or nullptr if the handle is stale or the sprite failed to load
+        class Sprite *GetSprite(SpriteHandle handle) const
+        {
+            if (handle.index >= mSpriteSlots.size() || mSpriteSlots[handle.index].generation != handle.generation)
+                return nullptr;
+            return mSpriteSlots[handle.index].sprite.get();
+        }
+        // Get a shared pointer to the sprite a handle refers to
+        std::shared_ptr<class Sprite> GetSharedSprite(SpriteHandle handle) const;
+        // Whether a handle still refers to a sprite in the cache
+        bool IsSpriteHandleValid(SpriteHandle handle) const { return handle.IsValid() && handle.index < mSpriteSlots.size() && mSpriteSlots[handle.index].generation == handle.generation; }
+        // Get a const reference to the map of sprite names to handles
+        const std::unordered_map<std::string, SpriteHandle> &GetSpriteCache() { return mSpriteCache; }
 #pragma endregion
 
 #pragma region Actors
@@ -296,33 +520,63 @@ namespace junebug
         void RemoveActor(class Actor *actor);
 
         // Get a const reference to the list of all actors
+        // Actors deleted during the update are never in the list
         /// @returns A const reference to the list of actors
-        const std::vector<class Actor *> &GetAllActors() const
-        {
-            return mActors;
-        };
-
-        // Get a list of actors of a certain type
-        /// @returns A list of actors
+        const std::vector<class Actor *> &GetAllActors() const;
+
+        // Get a list of actors of a certain type, including types derived from it
+        // The list is kept up to date as actors are created and destroyed, so querying it every frame is cheap
+        // Actors are in the order they were created, not sorted by depth
+        // While the returned list exists, it's safe to iterate while creating actors or querying other types
+        // Actors created in the meantime aren't added until it's gone, and actors deleted in the meantime are left as nullptrs
+        /// @returns The list of actors
         template <typename T>
-        const std::vector<T *> GetActors() const
+        ActorList<T> GetActors()
+        {
+            return mActorRegistry.Get<T>(mActors);
+        }
+        // Call a function on every actor of a certain type, including ones created while another actor list is being iterated
+        /// @param func Called with a pointer to each actor
+        template <typename T, typename F>
+        void ForEachActor(F &&func)
         {
-            std::vector<T *> res;
-            for (auto actor : mActors)
+            for (T *actor : GetActors<T>())
             {
-                auto cast = dynamic_cast<T *>(actor);
-                if (cast)
-                    res.push_back(cast);
+                if (actor)
+                    func(actor);
             }
-
-            return res;
+            mActorRegistry.ForEachPending<T>(func);
         }
 
         // Get an optionally typed actor by id
         /// @param id The id of the actor
-        /// @returns A pointer to the actor or nullptr if no actor with the given id exists
+        /// @returns A pointer to the actor or nullptr if no actor of type T with the given id exists
         template <typename T = class Actor>
-        T *GetActor(std::string id);
+        T *GetActor(const std::string &id) const
+        {
+            return mActorRegistry.Find<T>(id);
+        }
+
+        // Change an actor's id
+        // Use Actor::SetId() instead
+        void SetActorId(class Actor *actor, const std::string &id);
+
+        // Re-sort the actor list by depth before the next update or draw
+        // Called automatically when an actor's depth changes
+        void MarkActorOrderDirty() { mActorOrderDirty = true; }
+
+        // Create a component
+        // If GameOptions::componentPasses is on, the component is updated in a pass with every other component of its type
+        /// @param args The arguments to the component's constructor, starting with its owner
+        /// @returns The new component, owned by its actor
+        template <typename T, typename... Args>
+        T *CreateComponent(Args &&...args)
+        {
+            T *comp = new T(std::forward<Args>(args)...);
+            if (options.componentPasses)
+                GetComponentPass<T>(comp->GetUpdateOrder())->Add(comp);
+            return comp;
+        }
 
         typedef std::unordered_map<std::string,
                                    std::function<class Actor *()>>
@@ -330,65 +584,8 @@ namespace junebug
         // Actor name to class map
         factory_map mActorConstructors;
 
-        template <typename T>
-        using twerp_map = std::unordered_map<class Actor *, std::vector<T>>;
-        // Register a twerp coroutine
-        template <typename T>
-        void RegisterTwerpAsync(class Actor *actor, T prop, twerp_map<T> &map)
-        {
-            if (actor)
-            {
-                map[actor].push_back(prop);
-            }
-        }
-        twerp_map<TwerpPropertyFloat> &GetTwerpAsyncsFloat() { return mTwerpAsyncsFloat; }
-        twerp_map<TwerpPropertyInt> &GetTwerpAsyncsInt() { return mTwerpAsyncsInt; }
-        twerp_map<TwerpPropertyUint8> &GetTwerpAsyncsUint8() { return mTwerpAsyncsUint8; }
-
-        template <typename T>
-        bool ToggleTwerpAsync(Actor *actor, T prop, twerp_map<T> &map, int forceState = -1)
-        {
-            if (actor)
-            {
-                auto &entry = map[actor];
-                for (auto &entryProp : entry)
-                {
-                    if (entryProp.value == prop.value)
-                    {
-                        if (forceState == -1)
-                            entryProp.time = -entryProp.time;
-                        else if (forceState == 0)
-                            entryProp.time = -abs(entryProp.time);
-                        else if (forceState == 1)
-                            entryProp.time = abs(entryProp.time);
-                        return true;
-                    }
-                }
-            }
-            return false;
-        }
-
-        template <typename T>
-        bool StopTwerpAsync(Actor *actor, T prop, twerp_map<T> &map)
-        {
-            if (actor)
-            {
-                auto &entry = map[actor];
-                for (auto it = entry.begin(); it != entry.end(); ++it)
-                {
-                    auto &entryProp = *it;
-                    if (entryProp.value == prop.value)
-                    {
-                        entry.erase(it);
-                        if (entry.empty())
-                            map.erase(actor);
-
-                        return true;
-                    }
-                }
-            }
-            return false;
-        }
+        // Get the engine running every twerp coroutine
+        TwerpEngine &GetTwerps() { return mTwerps; }
 #pragma endregion
 
 #pragma region Collision
@@ -399,10 +596,20 @@ namespace junebug
         /// @param component The component to remove
         void RemoveCollision(class Collider *component);
 
+        // Refresh a collision component's broadphase cells after it moves
+        /// @param component The component to update
+        void UpdateCollision(class Collider *component);
+
         typedef std::unordered_map<std::string, std::vector<class Collider *>> collision_layers;
         // Get a const reference to the list of collision components
         /// @returns A const reference to the list of collision components
         const collision_layers &GetCollLayers() const;
+        // Get the collision components in a layer that might overlap a bounding box
+        /// @param layer The collision layer to search
+        /// @param topLeft The top left corner of the box
+        /// @param bottomRight The bottom right corner of the box
+        /// @param out The vector to fill with candidate components, in the order they were added
+        void QueryCollisions(const std::string &layer, const Vec2<float> &topLeft, const Vec2<float> &bottomRight, std::vector<class Collider *> &out);
 #pragma endregion
 
 #pragma region Cameras
@@ -434,6 +641,33 @@ namespace junebug
         /// @param path The path to the texture file
         /// @returns A pointer to the loaded texture
         SDL_Texture *GetTexture(std::string fileName);
+        // Load an image from a file, packing it into the texture atlas if possible
+        /// @param fileName The path to the image file
+        /// @returns The texture and the region within it that holds the image
+        TextureRegion GetTextureRegion(std::string fileName);
+        // Get the texture atlas that sprite frames are packed into
+        TextureAtlas &GetTextureAtlas() { return mAtlas; }
+        // Find an image that's already been uploaded, without touching the disk
+        /// @returns True if the image was found
+        bool FindTextureRegion(const std::string &fileName, TextureRegion &region);
+        // Upload an image that was already decoded, packing it into the texture atlas if possible
+        /// @param fileName The name to store the image under
+        /// @param surface The decoded image; ownership stays with the caller
+        TextureRegion AddTextureSurface(const std::string &fileName, SDL_Surface *surface);
+
+        // Start loading a sprite in the background
+        /// @param imagePath The path to the sprite, relative to the sprites folder
+        /// @param group An optional group name, used to track progress for a set of sprites
+        void PreloadSprite(std::string imagePath, std::string group = "");
+        // Get the fraction of a preload group that has finished loading
+        /// @param group The group to check, or "" for every preloaded sprite
+        /// @returns A value from 0 to 1
+        float GetPreloadProgress(std::string group = "") { return mAssetLoader.GetProgress(group).Fraction(); }
+        // Whether any sprites in a preload group are still loading
+        /// @param group The group to check, or "" for every preloaded sprite
+        bool IsPreloading(std::string group = "") { return mAssetLoader.IsLoading(group); }
+        // Get the background asset loader
+        AssetLoader &GetAssetLoader() { return mAssetLoader; }
 #pragma endregion
 
 #pragma region Scenes
@@ -482,6 +716,21 @@ namespace junebug
         // Get a pointer to the current scene's JSON file object
         /// @returns A pointer to the current scene's JSON file object
         Json *GetSceneJSON() { return mSceneInfo; }
+
+        // Get the sprites a scene's actors reference
+        /// @param scene The scene's name or JSON string
+        /// @returns The sprite paths, relative to the sprites folder, without duplicates
+        std::vector<std::string> GetSceneManifest(std::string scene);
+        // Parse a scene and start loading its sprites in the background
+        // The scene's sprites are preloaded under a group with the same name as the scene
+        // Transitions call this automatically, so the scene swap only needs to create actors
+        // Loading any scene drops every prefetched scene, so prefetch after a scene loads, not before
+        /// @param scene The scene's name or JSON string
+        void PrefetchScene(std::string scene);
+        // Get the fraction of a prefetched scene's sprites that have finished loading
+        /// @param scene The scene's name or JSON string
+        /// @returns A value from 0 to 1
+        float GetScenePrefetchProgress(std::string scene) { return GetPreloadProgress(scene); }
 #pragma endregion
 
 #pragma region Fonts
@@ -519,12 +768,17 @@ namespace junebug
 
 #pragma region Debug Tools
         // Start a debug checkpoint for the given step
+        // Checkpoints are profiler zones looked up by name; JB_PROFILE_ZONE() is cheaper and closes itself
         /// @param name The name of the checkpoint
         /// @param condition Whether to start the checkpoint; used for cleaner conditionals to keep debug code clean
         static void DebugCheckpoint(std::string name, bool condition = true);
         // Stop the current debug checkpoint
         /// @param name The name of the checkpoint
         static void DebugCheckpointStop(std::string name);
+        // Write the profiler's recent zones to a file in the Chrome trace format
+        /// @param path The file to write to
+        /// @returns True if the file was written
+        bool ExportProfilerTrace(std::string path) { return Profiler::Get().ExportTrace(path); }
         // Pause the debug printout for a frame
         // Useful for temporarily halting the ouput
         // This really isn't a function that has a public purpose but it needs to be public to be accessible from namespace-scoped functions
@@ -552,18 +806,16 @@ namespace junebug
         bool mGameIsRunning = false;
         // Current time between frames
         float mDeltaTime = 0;
-        // The inverse of the target framerate
-        system_clock::duration mInvTargetFps = round<system_clock::duration>(dsec{1. / 60});
-        system_clock::duration mSleepMargin = round<system_clock::duration>(dsec{1. / 1000});
-        // The previous time in seconds
-        time_point<system_clock, seconds> mPrevSecond;
-        // The accumulated frames in the current second
-        int mFramesThisSecond;
-        time_point<system_clock, nanoseconds> mBeginFrame = system_clock::now();
-        time_point<system_clock, nanoseconds> mEndFrame;
-        // The FPS of the previous frame
-        unsigned int mFps = 0;
+        // Time that hasn't been simulated yet by fixed updates
+        float mFixedAccumulator = 0.0f;
+        float mInterpolationAlpha = 1.0f;
+        // Run as many fixed updates as the elapsed time allows
+        void RunFixedUpdates();
+        // Waits between frames and tracks frame times
+        FramePacer mFramePacer;
         void HaltFrame();
+        // Set up everything that doesn't depend on the window or renderer
+        bool InitGame();
         // The number of frames that have elapsed since the game started
         unsigned long mFrameCount = 0;
 
@@ -582,6 +834,9 @@ namespace junebug
         // Whether the game is currently in fullscreen mode
         bool mFullscreen = false;
 
+        // The number of SDL_RENDER_TARGETS_RESET or SDL_RENDER_DEVICE_RESET events received
+        unsigned int mRenderTargetResets = 0;
+
         // Main input handling event
         void ProcessInput();
         // Main update event
@@ -591,6 +846,35 @@ namespace junebug
 
         // Comparator function for the actor vector
         static bool CompareActors(Actor *a1, Actor *a2);
+        // Delete every actor marked for destruction
+        // The actor list is compacted in a single pass, so destroying many actors at once stays linear
+        void DestroyQueuedActors();
+        // Sort the actor list by depth, keeping actors of equal depth in the order they were spawned
+        void SortActors();
+
+        // Component passes, sorted by update order
+        std::vector<std::unique_ptr<ComponentPass>> mComponentPasses;
+        std::map<std::pair<std::type_index, int>, ComponentPass *> mComponentPassIds;
+        // Passes created while the passes are being updated, added to the list once they finish
+        std::vector<std::unique_ptr<ComponentPass>> mQueuedComponentPasses;
+        bool mUpdatingComponentPasses = false;
+        // Get the pass for a component type and update order, creating it if needed
+        template <typename T>
+        TypedComponentPass<T> *GetComponentPass(int updateOrder)
+        {
+            auto key = std::make_pair(std::type_index(typeid(T)), updateOrder);
+            auto it = mComponentPassIds.find(key);
+            if (it != mComponentPassIds.end())
+                return static_cast<TypedComponentPass<T> *>(it->second);
+
+            TypedComponentPass<T> *pass = new TypedComponentPass<T>(updateOrder, mJobs);
+            AddComponentPass(pass);
+            mComponentPassIds[key] = pass;
+            return pass;
+        }
+        // Insert a pass after every pass with the same or an earlier update order
+        // Passes added while the passes are being updated are queued until they finish
+        void AddComponentPass(ComponentPass *pass);
 
         // Overridable function for loading game resources on startup
         virtual void LoadData();
@@ -601,9 +885,102 @@ namespace junebug
         virtual void LoadActor(Actor *actor, rapidjson::Value &actorRef, Scene &newScene);
 
         // Inputs
-        std::vector<std::unordered_map<std::string, std::pair<std::vector<Uint8>, std::pair<int, float>>>> mInputMappings;
-        std::unordered_map<Uint8, std::pair<int, float>> mInputs;
-        Uint8 mExtraStates[256] = {0};
+        // One player's mapping and state for an action
+        struct ActionState
+        {
+            std::vector<InputCode> inputs;
+            bool mapped = false;
+            // The longest any of the action's inputs has been held, in frames and seconds
+            int frames = 0;
+            float time = 0.0f;
+            // Whether the action was held last update and isn't anymore
+            bool released = false;
+            // The furthest any of the action's inputs is held, from 0 to 1
+            float value = 0.0f;
+        };
+        // Action names to IDs
+        std::unordered_map<std::string, ActionId> mActionIds;
+        // Every player's actions, indexed by ActionId
+        std::vector<std::vector<ActionState>> mActionStates;
+        // How long each input code has been held, in frames and seconds
+        // Gamepad codes only count scripted inputs here, since each player's gamepad is tracked separately
+        int mInputFrames[kNumInputCodes] = {0};
+        float mInputTimes[kNumInputCodes] = {0.0f};
+        // The IDs of the default window inputs
+        ActionId mQuitAction = kNoAction, mFullscreenAction = kNoAction;
+        // Get a player's state for an action
+        /// @returns The state, or nullptr if the player or action doesn't exist
+        ActionState *GetActionState(ActionId action, int player);
+        Uint8 mExtraStates[kNumInputCodes] = {0};
+        // Inputs held down by SetInputState()
+        Uint8 mScriptedStates[kNumInputCodes] = {0};
+        // Presses and releases since the previous update
+        std::vector<InputEvent> mInputEvents;
+        // How many times each input code went down since the previous update
+        Uint8 mInputPresses[kNumInputCodes] = {0};
+        // Callbacks indexed by ActionId
+        std::vector<ActionCallback> mActionCallbacks;
+        // Store a press or release and run any callbacks watching it
+        /// @param player The player whose gamepad sent the event, or -1 for the keyboard and mouse
+        void QueueInputEvent(InputCode input, bool down, Uint32 timestamp, int player = -1);
+        // Set the mouse position in screen coordinates and find its position relative to the screen cameras
+        void SetMouseScreenPos(Vec2<int> screenPos);
+
+        // Gamepads
+        // One player's gamepad and the state of its inputs, indexed from PAD_A
+        struct Gamepad
+        {
+            SDL_GameController *controller = nullptr;
+            SDL_JoystickID id = -1;
+            // How far each input is held, from 0 to 1, after the dead zone
+            float values[kNumPadInputs] = {0.0f};
+            // How many times each input went down since the previous update
+            Uint8 presses[kNumPadInputs] = {0};
+            int frames[kNumPadInputs] = {0};
+            float times[kNumPadInputs] = {0.0f};
+        };
+        // Gamepads indexed by player
+        // A player keeps their slot while disconnected, so reconnecting gives the gamepad back to them
+        std::vector<Gamepad> mGamepads;
+        bool mGamepadsStarted = false;
+        // Start the gamepad subsystem
+        // Gamepads that are already plugged in are opened by the hot-plug events that follow
+        void StartGamepads();
+        void StopGamepads();
+        // Handle a gamepad hot-plug, button or axis event
+        void ProcessGamepadEvent(const SDL_Event &event);
+        // Get the player using a gamepad
+        /// @returns The player, or -1 if no player has it
+        int FindGamepadPlayer(SDL_JoystickID id);
+        // Get a player's gamepad slot, adding slots up to it if needed
+        Gamepad &GetGamepadSlot(int player);
+        // Set how far a player's gamepad input is held, queuing an event if it was pressed or released
+        /// @param pad The input's index from PAD_A
+        /// @param value The value after the dead zone, from 0 to 1
+        void SetPadValue(int player, int pad, float value, Uint32 timestamp);
+        // Release every input on a player's gamepad
+        void ReleasePadInputs(int player, Uint32 timestamp);
+
+        // Input recordings
+        SDL_RWops *mRecordFile = nullptr, *mReplayFile = nullptr;
+        // The device inputs as of the last recorded frame
+        Uint8 mRecordedStates[kNumInputCodes] = {0};
+        // Each player's gamepad values as of the last recorded frame
+        std::vector<std::vector<float>> mRecordedPadValues;
+        Vec2<int> mRecordedMousePos = Vec2<int>::Zero;
+        // The device inputs being played back
+        // At least as large as SDL's keyboard state, since it's passed to InputsProcessed() in its place
+        Uint8 mReplayStates[kNumInputCodes] = {0};
+        // The version of the recording being played back
+        Uint16 mReplayVersion = 0;
+        // The seed the random generators were last given
+        unsigned int mRandomSeed = 0;
+        // Seed both the engine's and the C library's random generators
+        void SeedRandom(unsigned int seed);
+        void WriteRecordingFrame(const Uint8 *state);
+        // Read the next frame of the replay into the replay states, mouse position and delta time
+        // Stops the replay at the end of the file
+        void ReadReplayFrame();
         // Flush all poll events
         // Useful for events like window resizing
         void FlushPollEvents();
@@ -617,18 +994,51 @@ namespace junebug
 
         // Actor list
         std::vector<class Actor *> mActors;
+        // Actors indexed by type and id
+        ActorRegistry mActorRegistry;
+        // Actors that are being destroyed this frame
+        // Kept between frames so destroying actors doesn't allocate
+        std::vector<class Actor *> mDestroyQueue;
+        // Whether the actor list needs to be sorted by depth again
+        bool mActorOrderDirty = false;
+        // Whether the actor list is being iterated by UpdateGame()
+        // Actors removed during this leave a null gap instead of shifting the list
+        bool mUpdatingActors = false;
+        // The number of null gaps in the actor list
+        size_t mActorGaps = 0;
+        // The actor list without its gaps, handed out while there are any
+        mutable std::vector<class Actor *> mActorsView;
+        mutable bool mActorsViewDirty = false;
+        // The spawn order given to the next actor, used to keep actors of equal depth in a fixed order
+        uint64_t mNextSpawnOrder = 0;
 
         // Camera list
         std::vector<class Camera *> mCameras;
         // Game render target
         SDL_Texture *mRenderTarget = nullptr;
+        // Queue of batched sprite draws
+        RenderQueue mRenderQueue;
         // Active camera
         class Camera *mActiveCamera = nullptr;
 
         // Texture map
         std::unordered_map<std::string, SDL_Texture *> mTextures;
-        // Sprite cache
-        std::unordered_map<std::string, std::shared_ptr<class Sprite>> mSpriteCache;
+        // Packed sprite frames
+        TextureAtlas mAtlas;
+        // Background sprite loader
+        AssetLoader mAssetLoader;
+        // Worker threads for parallel updates
+        JobSystem mJobs;
+        // Sprite registry, indexed by SpriteHandle
+        struct SpriteSlot
+        {
+            std::shared_ptr<class Sprite> sprite;
+            unsigned int generation = 1;
+        };
+        std::vector<SpriteSlot> mSpriteSlots;
+        std::vector<unsigned int> mFreeSpriteSlots;
+        // Sprite cache, only used to find a sprite's handle when loading
+        std::unordered_map<std::string, SpriteHandle> mSpriteCache;
 
         // Scene
         Scene mScene;
@@ -642,70 +1052,23 @@ namespace junebug
         Vec2<float> mGravity = Vec2<>::Zero;
         // Currently loaded JSON scene file
         Json *mSceneInfo = nullptr;
+        // Scenes parsed ahead of time by PrefetchScene(), keyed by the name they were queued with
+        std::unordered_map<std::string, std::unique_ptr<Json>> mPrefetchedScenes;
+        // Helper function to parse a scene from a name or JSON string
+        /// @returns The parsed scene, or nullptr if it's invalid
+        std::unique_ptr<Json> LoadSceneJson(std::string &sceneStr);
         // A bool tracking if the scene is transitioning
         bool mIsTransitioning = false;
 
         // Collision map
         collision_layers mCollLayers;
+        // Broadphase grid for each collision layer
+        std::unordered_map<std::string, SpatialHash> mCollGrids;
 
         // Twerp coroutines
-        twerp_map<TwerpPropertyFloat> mTwerpAsyncsFloat;
-        twerp_map<TwerpPropertyInt> mTwerpAsyncsInt;
-        twerp_map<TwerpPropertyUint8> mTwerpAsyncsUint8;
+        TwerpEngine mTwerps;
         // Helper function to update all twerp coroutines
         void UpdateTwerps(float dt);
-        template <typename T>
-        void UpdateTwerpList(twerp_map<T> &twerpMap, float dt)
-        {
-            for (auto it2 = twerpMap.begin(); it2 != twerpMap.end();)
-            {
-                auto &actor = it2->first;
-                auto &props = it2->second;
-                if (!actor)
-                    continue;
-                for (auto it = props.begin(); it != props.end();)
-                {
-                    if (it->time < 0.0f)
-                    {
-                        ++it;
-                        continue;
-                    }
-
-                    it->timeElapsed += dt;
-                    if (it->timeElapsed >= it->time)
-                    {
-                        if (it->looped)
-                            it->timeElapsed = fmod(it->timeElapsed, it->time);
-                        else
-                        {
-                            *it->value = it->end;
-                            it = props.erase(it);
-                            if (props.empty())
-                            {
-                                it2 = twerpMap.erase(it2);
-                                break;
-                            }
-                            continue;
-                        }
-                    }
-
-                    *it->value = Twerp(it->start, it->end, it->timeElapsed / it->time, it->type, it->opt1, it->opt2);
-                    ++it;
-                }
-
-                if (it2 != twerpMap.end())
-                    ++it2;
-            }
-        }
-
-        template <typename T>
-        int CountTwerps(twerp_map<T> &twerpMap)
-        {
-            int count = 0;
-            for (auto &actor : twerpMap)
-                count += actor.second.size();
-            return count;
-        }
 
         // Current font
         FC_Font *mCurrentFont = nullptr;
@@ -725,10 +1088,8 @@ namespace junebug
         bool mShowDebugInfo = true;
         bool mSkipDebugPrintThisFrame = false;
 
-        std::vector<std::tuple<std::string, time_point<system_clock, nanoseconds>, bool>> mDebugCheckpoints;
-        time_point<system_clock, nanoseconds> mDebugCheckpointStart;
+        float mDebugPrintTimer = 0.0f;
         void DebugPrintCheckpoints();
-        void DebugResetCheckpoints();
 
     private:
         bool _GameLoopIteration();
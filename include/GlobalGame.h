@@ -14,10 +14,10 @@
 namespace junebug
 {
 #pragma region Input
-    // Check a given input name.
+    // Check a given input name or ID.
     /// @param key The name of the input to check
-    /// @returns number of frames the input has been held for
-    inline float Input(std::string key, int player = 0)
+    /// @returns number of seconds the input has been held for
+    inline float Input(const std::string &key, int player = 0)
     {
         return Game::Get()->Input(key, player);
     };
@@ -25,10 +25,14 @@ namespace junebug
     {
         return Game::Get()->Input(key.first, player);
     };
+    inline float Input(ActionId action, int player = 0)
+    {
+        return Game::Get()->Input(action, player);
+    };
     // Check if a given input is pressed.
     /// @param key The name of the input to check
     /// @returns true if the input was first pressed this frame, false otherwise
-    inline bool InputPressed(std::string key, int player = 0)
+    inline bool InputPressed(const std::string &key, int player = 0)
     {
         return Game::Get()->InputPressed(key, player);
     };
@@ -36,10 +40,29 @@ namespace junebug
     {
         return Game::Get()->InputPressed(key.first, player);
     };
+    inline bool InputPressed(ActionId action, int player = 0)
+    {
+        return Game::Get()->InputPressed(action, player);
+    };
+    // Check if a given input was released.
+    /// @param key The name of the input to check
+    /// @returns true if the input was let go this frame, false otherwise
+    inline bool InputReleased(const std::string &key, int player = 0)
+    {
+        return Game::Get()->InputReleased(key, player);
+    };
+    inline bool InputReleased(input_mapping key, int player = 0)
+    {
+        return Game::Get()->InputReleased(key.first, player);
+    };
+    inline bool InputReleased(ActionId action, int player = 0)
+    {
+        return Game::Get()->InputReleased(action, player);
+    };
     // Get the int result of two opposite inputs.
     /// @param key1 The first input
     /// @param key2 The second input
-    inline int InputsDir(std::string negKey, std::string posKey, int player = 0)
+    inline int InputsDir(const std::string &negKey, const std::string &posKey, int player = 0)
     {
         return Game::Get()->InputsDir(negKey, posKey, player);
     };
@@ -47,10 +70,14 @@ namespace junebug
     {
         return Game::Get()->InputsDir(negKey.first, posKey.first, player);
     };
+    inline int InputsDir(ActionId negAction, ActionId posAction, int player = 0)
+    {
+        return Game::Get()->InputsDir(negAction, posAction, player);
+    };
     // Get the int result of two opposite inputs being pressed this frame.
     /// @param key1 The first input
     /// @param key2 The second input
-    inline int InputsPressedDir(std::string negKey, std::string posKey, int player = 0)
+    inline int InputsPressedDir(const std::string &negKey, const std::string &posKey, int player = 0)
     {
         return Game::Get()->InputsPressedDir(negKey, posKey, player);
     };
@@ -58,6 +85,40 @@ namespace junebug
     {
         return Game::Get()->InputsPressedDir(negKey.first, posKey.first, player);
     };
+    inline int InputsPressedDir(ActionId negAction, ActionId posAction, int player = 0)
+    {
+        return Game::Get()->InputsPressedDir(negAction, posAction, player);
+    };
+    // Check how far a given input is held down.
+    /// @param key The name of the input to check
+    /// @returns 1 for held buttons and keys, how far a stick or trigger is pushed for analog inputs, or 0 if it's not held
+    inline float InputValue(const std::string &key, int player = 0)
+    {
+        return Game::Get()->InputValue(key, player);
+    };
+    inline float InputValue(input_mapping key, int player = 0)
+    {
+        return Game::Get()->InputValue(key.first, player);
+    };
+    inline float InputValue(ActionId action, int player = 0)
+    {
+        return Game::Get()->InputValue(action, player);
+    };
+    // Get the analog result of two opposite inputs.
+    /// @param negKey The input for the negative direction
+    /// @param posKey The input for the positive direction
+    inline float InputsAxis(const std::string &negKey, const std::string &posKey, int player = 0)
+    {
+        return Game::Get()->InputsAxis(negKey, posKey, player);
+    };
+    inline float InputsAxis(input_mapping negKey, input_mapping posKey, int player = 0)
+    {
+        return Game::Get()->InputsAxis(negKey.first, posKey.first, player);
+    };
+    inline float InputsAxis(ActionId negAction, ActionId posAction, int player = 0)
+    {
+        return Game::Get()->InputsAxis(negAction, posAction, player);
+    };
 #pragma endregion
 
 #pragma region Camera
@@ -4,6 +4,7 @@
 #endif
 
 #include "SDL2/SDL_scancode.h"
+#include "SDL2/SDL_stdinc.h"
 
 namespace junebug
 {
@@ -223,5 +224,51 @@ namespace junebug
         MOUSE_RIGHT,
         MOUSE_X1,
         MOUSE_X2,
+
+        // Gamepad buttons, in SDL_GameControllerButton order
+        // Gamepad inputs are read from the controller of the player they're mapped for
+        PAD_A = 256,
+        PAD_B,
+        PAD_X,
+        PAD_Y,
+        PAD_BACK,
+        PAD_GUIDE,
+        PAD_START,
+        PAD_LEFT_STICK_CLICK,
+        PAD_RIGHT_STICK_CLICK,
+        PAD_LEFT_SHOULDER,
+        PAD_RIGHT_SHOULDER,
+        PAD_DPAD_UP,
+        PAD_DPAD_DOWN,
+        PAD_DPAD_LEFT,
+        PAD_DPAD_RIGHT,
+        PAD_MISC,
+        PAD_PADDLE1,
+        PAD_PADDLE2,
+        PAD_PADDLE3,
+        PAD_PADDLE4,
+        PAD_TOUCHPAD,
+
+        // Gamepad axes, split into one input per direction
+        PAD_LEFT_STICK_LEFT,
+        PAD_LEFT_STICK_RIGHT,
+        PAD_LEFT_STICK_UP,
+        PAD_LEFT_STICK_DOWN,
+        PAD_RIGHT_STICK_LEFT,
+        PAD_RIGHT_STICK_RIGHT,
+        PAD_RIGHT_STICK_UP,
+        PAD_RIGHT_STICK_DOWN,
+        PAD_LEFT_TRIGGER,
+        PAD_RIGHT_TRIGGER,
     } KEYS;
+
+    // A keyboard scancode, mouse button or gamepad input from the list above
+    typedef Uint16 InputCode;
+    // The number of input codes
+    const int kNumInputCodes = 512;
+    // The number of gamepad inputs, which start at PAD_A
+    const int kNumPadInputs = PAD_RIGHT_TRIGGER - PAD_A + 1;
+
+    // Whether an input code comes from a gamepad
+    inline bool IsPadInput(InputCode input) { return input >= PAD_A && input <= PAD_RIGHT_TRIGGER; }
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace junebug
+{
+    // A pool of worker threads for splitting loops across cores
+    // Each thread starts with an even share of a loop's batches and steals from the back of the others' shares once its own runs out
+    // Batches are fixed by the loop's length and batch size, so as long as each index only writes its own data, results don't depend on the thread count
+    class JobSystem
+    {
+    public:
+        JobSystem() = default;
+        ~JobSystem();
+        JobSystem(const JobSystem &) = delete;
+        JobSystem &operator=(const JobSystem &) = delete;
+
+        // Start the worker threads
+        /// @param threadCount The number of workers; 0 runs every loop on the calling thread
+        void Start(int threadCount);
+        // Stop the worker threads
+        void Stop();
+
+        // Get the number of worker threads, not counting the calling thread
+        int GetWorkerCount() const { return (int)mWorkers.size(); }
+
+        // Run a function over a range of indices, split into batches across the workers and the calling thread
+        // Blocks until every batch has finished
+        // Only call this from one thread at a time
+        /// @param count The number of indices
+        /// @param batchSize The number of indices per batch
+        /// @param func The function to run on each batch, given the batch's first index and one past its last
+        void ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)> &func);
+
+    private:
+        // A thread's share of the current loop's batches
+        struct Queue
+        {
+            std::mutex mutex;
+            size_t begin = 0, end = 0;
+        };
+
+        void WorkerLoop(int index);
+        // Run batches until every queue is empty
+        void RunBatches(int index);
+        bool PopBatch(int index, size_t &batch);
+        bool StealBatch(int index, size_t &batch);
+
+        std::vector<std::thread> mWorkers;
+        // One per worker, plus one for the calling thread
+        std::unique_ptr<Queue[]> mQueues;
+        int mQueueCount = 0;
+
+        std::mutex mMutex;
+        std::condition_variable mWake;
+        bool mStopping = false;
+        unsigned int mGeneration = 0;
+
+        // The current loop
+        const std::function<void(size_t, size_t)> *mFunc = nullptr;
+        size_t mCount = 0, mBatchSize = 1;
+        std::atomic<size_t> mRemaining{0};
+    };
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include <cstddef>
+
+namespace junebug
+{
+    // Memory usage of the pools
+    struct PoolStats
+    {
+        // Bytes taken from the heap for pooled blocks
+        size_t reservedBytes = 0;
+        // Blocks currently handed out
+        size_t blocksInUse = 0;
+    };
+
+    // Recycles memory for objects that are created and destroyed constantly, like actors and components
+    // Allocations are grouped into pools by size, so each actor or component type effectively gets a pool of its own
+    // Freed blocks go back to their pool rather than the heap, so once a pool is warm, spawning and destroying objects doesn't allocate
+    // This covers actors, components and the engine's per-actor bookkeeping, but not what an actor allocates itself
+    // An id longer than std::string's inline buffer, or a member container like a sprite path, still goes to the heap
+    // Not thread-safe; actors and components belong to the main thread
+    class Pool
+    {
+    public:
+        // Get a block of memory
+        /// @param size The number of bytes needed; sizes above the largest pool go straight to the heap
+        static void *Allocate(size_t size);
+        // Return a block of memory
+        /// @param size The size the block was allocated with
+        static void Free(void *ptr, size_t size);
+
+        // Make sure a pool has enough free blocks for a number of objects, so they can be created later without touching the heap
+        /// @param size The size of each object
+        /// @param count The number of objects
+        static void Reserve(size_t size, size_t count);
+        template <typename T>
+        static void Reserve(size_t count) { Reserve(sizeof(T), count); }
+
+        static PoolStats GetStats();
+
+        // Blocks are aligned to, and rounded up to a multiple of, this many bytes
+        static const size_t kGranularity = alignof(std::max_align_t);
+        // The largest pooled size
+        static const size_t kMaxBlockSize = 2048;
+
+    private:
+        // The minimum number of bytes taken from the heap when a pool runs out
+        static const size_t kChunkSize = 64 * 1024;
+
+        struct Block
+        {
+            Block *next;
+        };
+        struct Bucket
+        {
+            Block *free = nullptr;
+            size_t freeCount = 0;
+        };
+
+        // Plain arrays of plain structs, so the pools work before and after static constructors and destructors run
+        static Bucket sBuckets[kMaxBlockSize / kGranularity];
+        static PoolStats sStats;
+
+        static void Refill(Bucket &bucket, size_t blockSize, size_t count);
+    };
+
+    // Lets standard containers allocate from the pools
+    template <typename T>
+    struct PoolAllocator
+    {
+        typedef T value_type;
+
+        PoolAllocator() = default;
+        template <typename U>
+        PoolAllocator(const PoolAllocator<U> &) {}
+
+        T *allocate(size_t n)
+        {
+            static_assert(alignof(T) <= Pool::kGranularity, "Pooled types can't be over-aligned");
+            return static_cast<T *>(Pool::Allocate(n * sizeof(T)));
+        }
+        void deallocate(T *ptr, size_t n) { Pool::Free(ptr, n * sizeof(T)); }
+
+        template <typename U>
+        bool operator==(const PoolAllocator<U> &) const { return true; }
+        template <typename U>
+        bool operator!=(const PoolAllocator<U> &) const { return false; }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+
+namespace junebug
+{
+    // Timing for one profiler zone over the profiler's rolling window
+    // Times are the zone's total per frame, in milliseconds, over the frames it ran in
+    struct ZoneStats
+    {
+        std::string name;
+        // How deeply the zone was nested when it was first entered
+        int depth = 0;
+        // The number of frames in the window that the zone ran in
+        int frames = 0;
+        // The average number of times the zone was entered per frame
+        float calls = 0.0f;
+        float min = 0.0f, avg = 0.0f, max = 0.0f, p99 = 0.0f;
+    };
+
+    // Records how long named zones of code take
+    // Zones are identified by small IDs that are registered once per call site, so opening one is only a clock read and an array write
+    // Completed zones go into a preallocated ring buffer, so nothing is allocated while a frame runs
+    // Zones are only recorded on the thread that created or last reset the profiler, which is normally the main thread
+    class Profiler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        typedef uint16_t ZoneId;
+        // An ID that no zone has
+        static const ZoneId kNoZone = 0xffff;
+
+        // Get the global profiler
+        static Profiler &Get();
+
+        // Get the ID for a zone name, registering it if it's new
+        // Call this once per call site and keep the result, as JB_PROFILE_ZONE() does
+        static ZoneId RegisterZone(const std::string &name);
+
+        // Set whether zones are recorded
+        void SetEnabled(bool enabled) { mEnabled = enabled; }
+        bool IsEnabled() const { return mEnabled; }
+
+        // Set the number of frames the statistics are calculated over
+        void SetWindowSize(int frames);
+        int GetWindowSize() const { return mWindowSize; }
+
+        // Open a zone
+        /// @returns True if the zone was opened and must be closed with EndZone()
+        bool BeginZone(ZoneId id);
+        // Close the innermost open zone
+        /// @param id The zone to close; if it isn't the innermost zone, nothing is closed
+        void EndZone(ZoneId id);
+
+        // Add this frame's zone times to the rolling statistics
+        void EndFrame();
+        // Discard every recorded zone and statistic
+        void Reset();
+
+        // Get the statistics for every zone that ran in the window
+        // Zones are ordered so that each one comes after the zone it was first nested in
+        std::vector<ZoneStats> GetStats() const;
+
+        // Write the recorded zones to a file in the Chrome trace format
+        // The file can be opened in chrome://tracing or Perfetto
+        /// @param path The file to write to
+        /// @returns True if the file was written
+        bool ExportTrace(const std::string &path) const;
+
+    private:
+        Profiler();
+
+        // The most zones that can be open at once
+        static const int kMaxDepth = 64;
+        // The most zones that can be registered
+        static const size_t kMaxZones = 4096;
+        // The number of completed zones kept for traces
+        static const size_t kEventCapacity = 1 << 16;
+
+        struct Zone
+        {
+            std::string name;
+            ZoneId parent = kNoZone;
+            int depth = -1;
+
+            // Totals for the current frame
+            double frameTime = 0.0;
+            int frameCalls = 0;
+
+            // Per-frame totals for the last few frames the zone ran in, in milliseconds
+            std::vector<float> history;
+            std::vector<int> historyCalls;
+            // The frame each total was recorded on, so totals that have left the window can be skipped
+            std::vector<uint32_t> historyFrames;
+            int historyIndex = 0, historyCount = 0;
+        };
+
+        struct OpenZone
+        {
+            ZoneId id;
+            Clock::time_point start;
+        };
+
+        struct Event
+        {
+            ZoneId id;
+            uint8_t depth;
+            uint32_t frame;
+            // Nanoseconds since the profiler started
+            int64_t start, duration;
+        };
+
+        bool mEnabled = false;
+        int mWindowSize = 120;
+        Clock::time_point mEpoch;
+        uint32_t mFrame = 0;
+        std::thread::id mThread;
+
+        // Zones are registered from static initializers, which can run on any thread
+        static std::mutex sRegistryMutex;
+        std::vector<Zone> mZones;
+        std::unordered_map<std::string, ZoneId> mZoneIds;
+
+        OpenZone mStack[kMaxDepth];
+        int mDepth = 0;
+
+        // Zones that ran this frame
+        std::vector<ZoneId> mTouched;
+
+        std::vector<Event> mEvents;
+        size_t mEventHead = 0, mEventCount = 0;
+    };
+
+    // Opens a zone for as long as it's in scope
+    class ProfileScope
+    {
+    public:
+        ProfileScope(Profiler::ZoneId id, bool condition = true) : mId(id), mActive(condition && Profiler::Get().IsEnabled() && Profiler::Get().BeginZone(id)) {}
+        ~ProfileScope()
+        {
+            if (mActive)
+                Profiler::Get().EndZone(mId);
+        }
+
+        ProfileScope(const ProfileScope &) = delete;
+        ProfileScope &operator=(const ProfileScope &) = delete;
+
+    private:
+        Profiler::ZoneId mId;
+        bool mActive;
+    };
+}
+
+#define __JB_PROFILE_CONCAT_INNER__(a, b) a##b
+#define __JB_PROFILE_CONCAT__(a, b) __JB_PROFILE_CONCAT_INNER__(a, b)
+
+// Profile the rest of the current scope under a name
+// Define JB_DISABLE_PROFILER to compile every zone out
+#ifndef JB_DISABLE_PROFILER
+#define JB_PROFILE_ZONE_IF(name, condition)                                                                                          \
+    static const junebug::Profiler::ZoneId __JB_PROFILE_CONCAT__(__jbZone, __LINE__) = junebug::Profiler::RegisterZone(name); \
+    junebug::ProfileScope __JB_PROFILE_CONCAT__(__jbScope, __LINE__)(__JB_PROFILE_CONCAT__(__jbZone, __LINE__), condition)
+#else
+#define JB_PROFILE_ZONE_IF(name, condition)
+#endif
+#define JB_PROFILE_ZONE(name) JB_PROFILE_ZONE_IF(name, true)
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include "SDL2/SDL.h"
+#include <vector>
+
+namespace junebug
+{
+    // A single textured quad waiting to be drawn
+    struct RenderCommand
+    {
+        SDL_Texture *texture = nullptr;
+        SDL_Rect src, dest;
+        // Clockwise rotation in degrees around the center of dest
+        float rotation = 0.0f;
+        SDL_RendererFlip flip = SDL_FLIP_NONE;
+        SDL_Color color{255, 255, 255, 255};
+
+        // Sort keys, filled in by the queue
+        unsigned int order = 0, batch = 0;
+    };
+
+    // Collects sprite draws during a camera render and submits them in as few calls as possible
+    // Commands that share a texture are grouped, and each group is drawn with one SDL_RenderGeometry call
+    // A command only joins an earlier group if nothing drawn in between overlaps it, so the result matches submission order
+    class RenderQueue
+    {
+    public:
+        // Add a quad to the queue
+        /// @param command The quad to draw
+        void Submit(const RenderCommand &command);
+
+        // Draw every queued command to the current render target and clear the queue
+        /// @param renderer The renderer to draw with
+        void Flush(SDL_Renderer *renderer);
+
+        // Get the number of commands waiting to be drawn
+        size_t Size() const { return mCommands.size(); }
+        // Get the number of draw calls issued by the last flushes since ResetStats()
+        unsigned int GetDrawCalls() const { return mDrawCalls; }
+        void ResetStats() { mDrawCalls = 0; }
+
+        // Try SDL_RenderGeometry again after the renderer's targets or device were reset
+        void OnRendererReset() { mGeometryUnsupported = false; }
+
+    private:
+        // Commands drawn together with one texture
+        struct Batch
+        {
+            SDL_Texture *texture;
+            // Covers every command in the batch
+            SDL_Rect bounds;
+        };
+
+        std::vector<RenderCommand> mCommands;
+        std::vector<Batch> mBatches;
+        // Scratch buffers reused between flushes
+        std::vector<SDL_Vertex> mVertices;
+        std::vector<int> mIndices;
+
+        // Set if SDL_RenderGeometry failed, so future flushes go straight to SDL_RenderCopyEx
+        bool mGeometryUnsupported = false;
+        unsigned int mDrawCalls = 0;
+
+        void AddQuad(const RenderCommand &command, float invTexW, float invTexH);
+        void DrawImmediate(SDL_Renderer *renderer, const RenderCommand &command);
+    };
+}
\ No newline at end of file
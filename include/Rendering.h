@@ -13,9 +13,26 @@
 
 namespace junebug
 {
+    // A stable reference to a sprite in the game's sprite registry
+    // Resolving a handle is an array lookup, so prefer storing one over looking up a sprite by path every frame
+    struct SpriteHandle
+    {
+        unsigned int index = 0;
+        // Zero is never a live generation, so a default handle is always invalid
+        unsigned int generation = 0;
+
+        bool IsValid() const { return generation != 0; }
+        bool operator==(const SpriteHandle &other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const SpriteHandle &other) const { return !(*this == other); }
+    };
+
     // Get a position relative to a camera
     Vec2<float> GetDrawPosition(Vec2<float> pos = Vec2<float>::Zero);
     std::shared_ptr<class Sprite> LoadSprite(std::string &imagePath);
+    // Load a sprite if it isn't already loaded and get a handle to it
+    /// @param imagePath The path to the sprite's image or folder
+    /// @returns A handle to the sprite, which is valid even if the sprite failed to load
+    SpriteHandle LoadSpriteHandle(std::string &imagePath);
 
     struct SpriteProperties
     {
@@ -44,8 +61,10 @@ namespace junebug
 
     // Draw a sprite
     void DrawSprite(std::string &imagePath, int frame, const Vec2<float> &pos, const SpriteProperties &properties = {});
+    void DrawSprite(SpriteHandle sprite, int frame, const Vec2<float> &pos, const SpriteProperties &properties = {});
     // Draw a part of a sprite
     void DrawSpritePart(std::string &imagePath, int frame, const Vec2<float> &pos, const Vec2<int> &partPos, const Vec2<int> &partSize, const SpriteProperties &properties = {});
+    void DrawSpritePart(SpriteHandle sprite, int frame, const Vec2<float> &pos, const Vec2<int> &partPos, const Vec2<int> &partSize, const SpriteProperties &properties = {});
 
     struct TextEffects : FC_Effect
     {
@@ -0,0 +1,73 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include <unordered_map>
+#include <vector>
+
+#include "MathLib.h"
+
+namespace junebug
+{
+    // Uniform grid broadphase for a single collision layer
+    // Colliders are bucketed by the cells their bounding box covers, so a query only visits nearby colliders
+    // Colliders without finite bounds (like tilesets) are stored separately and returned by every query
+    class SpatialHash
+    {
+    public:
+        // Constructor
+        /// @param cellSize The width and height of each grid cell in world units
+        SpatialHash(float cellSize = 64.0f);
+
+        // Add a collider to the grid
+        /// @param coll The collider to add
+        void Insert(class Collider *coll);
+        // Remove a collider from the grid
+        /// @param coll The collider to remove
+        void Remove(class Collider *coll);
+        // Move a collider to the cells covered by its current bounds
+        // Does nothing if the covered cells haven't changed
+        /// @param coll The collider to update
+        void Update(class Collider *coll);
+
+        // Get every collider whose cells overlap a bounding box
+        // Results are deduplicated and returned in insertion order
+        /// @param topLeft The top left corner of the box
+        /// @param bottomRight The bottom right corner of the box
+        /// @param out The vector to fill with candidate colliders
+        void Query(const Vec2<float> &topLeft, const Vec2<float> &bottomRight, std::vector<class Collider *> &out);
+
+        // Set the size of each cell and rebuild the grid
+        /// @param cellSize The width and height of each grid cell in world units
+        void SetCellSize(float cellSize);
+        // Get the size of each cell
+        /// @returns The width and height of each grid cell in world units
+        float GetCellSize() const { return mCellSize; }
+
+        // Get the number of colliders in the grid
+        /// @returns The number of colliders
+        size_t Size() const { return mColliders.size(); }
+
+    private:
+        // Colliders covering more cells than this are treated as unbounded
+        static const int kMaxCells = 256;
+
+        float mCellSize, mInvCellSize;
+        // Every collider in the grid
+        // Colliders are swapped and popped out, since queries sort by insertion order themselves
+        std::vector<class Collider *> mColliders;
+        // Colliders that are checked against every query
+        std::vector<class Collider *> mUnbounded;
+        std::unordered_map<long long, std::vector<class Collider *>> mCells;
+        unsigned int mQueryStamp = 0;
+        unsigned int mNextOrder = 0;
+
+        long long CellKey(int x, int y) const { return ((long long)x << 32) ^ (unsigned int)y; }
+        // Compute the cell range a collider covers
+        /// @returns False if the collider should be treated as unbounded
+        bool GetCellRange(class Collider *coll, Vec2<int> &min, Vec2<int> &max) const;
+        void AddToCells(class Collider *coll);
+        void RemoveFromCells(class Collider *coll);
+    };
+}
\ No newline at end of file
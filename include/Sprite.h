@@ -6,6 +6,7 @@
 #include "Color.h"
 #include "MathLib.h"
 #include "Rendering.h"
+#include "TextureAtlas.h"
 
 #include "SDL2/SDL.h"
 #include <vector>
@@ -33,6 +34,9 @@ namespace junebug
         void Draw(class Camera *cam, SDL_Renderer *renderer, const Vec2<float> &pos, const Vec2<int> &partPos, const Vec2<int> &partSize, int frame, const SpriteProperties &properties);
         // Add a texture for this psirte
         virtual void AddTexture(SDL_Texture *texture);
+        // Add a frame from a region of a texture, such as an atlas page
+        /// @param frame The texture and the rectangle within it to draw
+        virtual void AddFrame(const TextureRegion &frame);
 
         // Get the height of the texture
         Vec2<int> GetTexSize() const { return mTexSize; }
@@ -42,25 +46,34 @@ namespace junebug
         // Get the origin of the sprite
         Vec2<int> GetOrigin() { return mOrigin; }
 
-        // Load a texture from a file
-        SDL_Texture *LoadTextureFile(std::string &fileName);
+        // Load a texture from a file and add it as a frame
+        /// @returns True if the frame was added
+        bool LoadTextureFile(std::string &fileName);
         // Load metadata from a file
         bool LoadMetadataFile(std::string &folder);
+        // Load metadata that was already parsed
+        /// @param folder The sprite's folder, used to find its frames
+        /// @param json The parsed contents of the sprite's metadata file
+        bool LoadMetadata(const std::string &folder, class Json &json);
 
         // Get the number of frames in this sprite
-        int GetNumFrames() const { return mTextures.size(); }
+        int GetNumFrames() const { return mFrames.size(); }
         // Get the FPS of this sprite
         float GetFps() const { return mFps; }
         // Set the FPS of this sprite
         void SetFps(float fps) { mFps = fps; }
 
-        // Set the textures for this sprite
-        void SetTextures(const std::vector<SDL_Texture *> &textures) { mTextures = textures; }
-        // Get the textures for this sprite
-        const std::vector<SDL_Texture *> &GetTextures() const { return mTextures; }
+        // Set the frames for this sprite
+        void SetFrames(const std::vector<TextureRegion> &frames) { mFrames = frames; }
+        // Get the frames for this sprite
+        // Frames packed into the same atlas page share a texture
+        const std::vector<TextureRegion> &GetFrames() const { return mFrames; }
 
         // Get a given animation
         const std::vector<int> &GetAnimation(const std::string &name = "_");
+        // Find an animation without adding it
+        /// @returns The animation, the default animation if it doesn't exist, or nullptr if neither exist
+        const std::vector<int> *FindAnimation(const std::string &name = "_") const;
         // Add an animation of the corresponding name to the animation map
         void AddAnimation(const std::string &name,
                           const std::vector<int> &frames);
@@ -73,8 +86,8 @@ namespace junebug
         const VerticesPtr &GetVertices() const { return mVertices; }
 
     protected:
-        // Texture to draw
-        std::vector<SDL_Texture *> mTextures;
+        // Texture regions to draw, one per frame
+        std::vector<TextureRegion> mFrames;
         // Width/height
         Vec2<int> mTexSize = Vec2<int>(0, 0);
         // Origin
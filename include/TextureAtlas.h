@@ -0,0 +1,98 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include "SDL2/SDL.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace junebug
+{
+    // A rectangle within a texture
+    struct TextureRegion
+    {
+        SDL_Texture *texture = nullptr;
+        SDL_Rect rect{0, 0, 0, 0};
+    };
+
+    // Packs many small images into a few large texture pages
+    // Images are placed with a bottom-left skyline packer as they are loaded
+    class TextureAtlas
+    {
+    public:
+        ~TextureAtlas();
+
+        // Set up the atlas for a renderer
+        /// @param renderer The renderer that will own the page textures
+        /// @param pageSize The width and height of each page, clamped to the renderer's limits
+        /// @param keepSurfaces Whether to keep a CPU copy of each page, which is required for SaveCache()
+        void Init(SDL_Renderer *renderer, int pageSize, bool keepSurfaces = false);
+
+        // Pack an image into the atlas
+        /// @param name The name to store the image under
+        /// @param surface The image to pack; ownership stays with the caller
+        /// @param region Filled with the packed region on success
+        /// @returns False if the image doesn't fit in a page
+        bool Insert(const std::string &name, SDL_Surface *surface, TextureRegion &region);
+        // Find an image that was already packed
+        /// @param name The name the image was stored under
+        /// @param region Filled with the packed region on success
+        /// @returns True if the image is in the atlas
+        bool Find(const std::string &name, TextureRegion &region) const;
+
+        // Save the pages and layout to a folder
+        /// @param folder The folder to write to
+        /// @returns True if the cache was written
+        bool SaveCache(const std::string &folder);
+        // Load pages and a layout written by SaveCache()
+        // Entries whose source files changed since the cache was written are skipped
+        /// @param folder The folder to read from
+        /// @returns True if the cache was loaded
+        bool LoadCache(const std::string &folder);
+
+        // Destroy all pages and forget every packed image
+        void Clear();
+
+        // Get the number of pages
+        int GetPageCount() const { return (int)mPages.size(); }
+        // Get the size of each page
+        int GetPageSize() const { return mPageSize; }
+        // Whether the atlas has changed since it was last saved or loaded
+        bool IsDirty() const { return mDirty; }
+
+    private:
+        struct SkylineNode
+        {
+            int x, y, width;
+        };
+        struct Page
+        {
+            SDL_Texture *texture = nullptr;
+            SDL_Surface *surface = nullptr;
+            std::vector<SkylineNode> skyline;
+        };
+        struct Entry
+        {
+            int page;
+            SDL_Rect rect;
+            long long modified;
+        };
+
+        SDL_Renderer *mRenderer = nullptr;
+        int mPageSize = 2048;
+        // Empty space left around each image to avoid bleeding when filtering
+        int mPadding = 1;
+        bool mKeepSurfaces = false;
+        bool mDirty = false;
+
+        std::vector<Page> mPages;
+        std::unordered_map<std::string, Entry> mEntries;
+
+        bool AddPage(SDL_Surface *contents = nullptr);
+        bool Pack(Page &page, int w, int h, SDL_Rect &rect);
+        int SkylineFit(const Page &page, size_t index, int w, int h) const;
+        void SkylineAdd(Page &page, size_t index, const SDL_Rect &rect);
+    };
+}
\ No newline at end of file
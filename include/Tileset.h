@@ -10,6 +10,51 @@
 
 namespace junebug
 {
+    // Read-only view over a contiguous row of tiles
+    struct TileRow
+    {
+        const int *data = nullptr;
+        int size = 0;
+
+        const int *begin() const { return data; }
+        const int *end() const { return data + size; }
+        int operator[](int i) const { return data[i]; }
+    };
+
+    // Flat, row-major storage for a grid of tiles
+    // Empty cells hold -1
+    class TileGrid
+    {
+    public:
+        TileGrid(){};
+        TileGrid(int width, int height, int fill = -1);
+        TileGrid(int width, int height, std::vector<int> tiles);
+        TileGrid(const std::vector<std::vector<int>> &rows);
+
+        int GetWidth() const { return mWidth; };
+        int GetHeight() const { return mHeight; };
+        Vec2<int> GetSize() const { return Vec2<int>(mWidth, mHeight); };
+        bool Empty() const { return mTiles.empty(); };
+
+        bool InBounds(int x, int y) const { return x >= 0 && y >= 0 && x < mWidth && y < mHeight; };
+        // Get a tile, or -1 if the position is out of bounds
+        int Get(int x, int y) const { return InBounds(x, y) ? mTiles[(size_t)y * mWidth + x] : -1; };
+        int Get(Vec2<int> pos) const { return Get(pos.x, pos.y); };
+        // Set a tile without bounds checking
+        void Set(int x, int y, int tile) { mTiles[(size_t)y * mWidth + x] = tile; };
+
+        // Resize the grid, keeping tiles that are still in bounds
+        /// @param fill The value for any new cells
+        void Resize(int width, int height, int fill = -1);
+
+        TileRow Row(int y) const { return {mTiles.data() + (size_t)y * mWidth, mWidth}; };
+        const std::vector<int> &Data() const { return mTiles; };
+
+    private:
+        int mWidth = 0, mHeight = 0;
+        std::vector<int> mTiles;
+    };
+
     class Tileset : public VisualActor
     {
     public:
@@ -22,15 +67,19 @@ namespace junebug
         };
 
         Tileset(std::string sprite = "", Vec2<int> tileSize = Vec2<int>::Zero, Vec2<float> pos = Vec2<>::Zero);
+        ~Tileset();
 
         void InternalFirstUpdate(float dt) override;
+        // Tiles are drawn from fixed frames, so the tileset's sprite isn't animated
+        void InternalParallelUpdate(float dt) override{};
         void InternalUpdate(float dt) override;
         void Draw() override;
 
         void SetTileSize(Vec2<int> tileSize) { mTileSize = tileSize; };
         Vec2<int> GetTileSize() const { return mTileSize; };
-        void SetTiles(std::vector<std::vector<int>> tiles) { mTiles = tiles; };
-        std::vector<std::vector<int>> GetTiles() const { return mTiles; };
+        void SetTiles(TileGrid tiles);
+        void SetTiles(const std::vector<std::vector<int>> &tiles) { SetTiles(TileGrid(tiles)); };
+        const TileGrid &GetTiles() const { return mTiles; };
 
         Vec2<int> WorldToTile(Vec2<float> pos);
         Vec2<int> WorldToTile(Vec2<int> pos) { return WorldToTile(Vec2<float>(pos)); }
@@ -71,13 +120,23 @@ namespace junebug
 
         int GetNumTiles() const { return mNumTiles; };
 
+        // Set whether static tiles are baked into cached chunk textures
+        // If false, each visible tile is drawn individually every frame
+        void SetChunkCaching(bool cache)
+        {
+            mChunkCaching = cache;
+            if (!cache)
+                ClearChunks();
+        };
+        bool GetChunkCaching() const { return mChunkCaching; };
+
     protected:
         friend class TileCollider;
         Vec2<int> mTileSize;
         int mNumTiles = -1;
         bool mCenterTopLeft{false};
 
-        std::vector<std::vector<int>> mTiles;
+        TileGrid mTiles;
 
         RoundDir mSpacingRoundDir{RoundDir::Down};
 
@@ -94,7 +153,43 @@ namespace junebug
         TilesetEditMode mEditMode{TilesetEditMode::None};
         input_mapping mDrawInput{JB_INPUT_LEFT_CLICK, {MOUSE_LEFT}}, mEraseInput{JB_INPUT_RIGHT_CLICK, {MOUSE_RIGHT}};
         input_mapping mRotateCWInput{"_tileCW", {KEY_E}}, mRotateCCWInput{"_tileCCW", {KEY_Q}}, mFlipXInput{"_tileX", {KEY_X}}, mFlipYInput{"_tileY", {KEY_Y}};
+        // The IDs of the inputs above, so editing doesn't look them up by name every frame
+        ActionId mDrawAction{kNoAction}, mEraseAction{kNoAction}, mRotateCWAction{kNoAction}, mRotateCCWAction{kNoAction}, mFlipXAction{kNoAction}, mFlipYAction{kNoAction};
         int mDrawTile{0}, mDrawAngle{0};
         Vec2<int> mDrawFlip{1, 1};
+
+        // The width and height of a cached chunk, in tiles
+        static const int kChunkSize = 16;
+        // Baked chunks that go this many frames without being on screen are freed
+        static const unsigned long kChunkIdleFrames = 300;
+        // The most baked chunks a tileset keeps; past this, the ones drawn longest ago are freed first
+        static const size_t kMaxBakedChunks = 256;
+        struct TileChunk
+        {
+            SDL_Texture *texture = nullptr;
+            bool dirty = true;
+            bool empty = true;
+            // The frame the chunk was last on screen
+            unsigned long lastDrawn = 0;
+        };
+        bool mChunkCaching{true};
+        std::vector<TileChunk> mChunks;
+        // The chunks that have a texture, so freeing idle ones doesn't walk the whole map
+        std::vector<uint32_t> mBakedChunks;
+        unsigned long mChunkEvictFrame = 0;
+        Vec2<int> mChunkCount;
+        // The state the chunks were baked with, so they can be invalidated when it changes
+        SpriteHandle mChunkSprite;
+        Vec2<int> mChunkTileSize;
+        unsigned int mChunkTargetResets = 0;
+
+        Vec2<int> GetTilePartPos(int tile, const Vec2<int> &sprSize);
+        void DrawTileRange(const Vec2<int> &min, const Vec2<int> &max, const Vec2<int> &sprSize);
+        void DrawChunks(const Vec2<int> &min, const Vec2<int> &max, const Vec2<int> &sprSize);
+        bool BakeChunk(TileChunk &chunk, const Vec2<int> &chunkPos, const Vec2<int> &sprSize);
+        void DirtyChunk(const Vec2<int> &tilePos);
+        void ClearChunks();
+        // Free the textures of chunks that haven't been on screen for a while
+        void EvictChunks(unsigned long frame);
     };
 }
\ No newline at end of file
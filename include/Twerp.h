@@ -3,7 +3,11 @@
 #define NAMESPACES
 #endif
 
+#include "MathLib.h"
+#include "Color.h"
+
 #include "SDL2/SDL.h"
+#include <cstddef>
 
 namespace junebug
 {
@@ -58,56 +62,32 @@ namespace junebug
     int Twerp(int _start, int _end, float _pos, TwerpType _type = TWERP_LINEAR, bool _looped = false, float _opt1 = Twerp_Undefined, float _opt2 = Twerp_Undefined);
     Uint8 Twerp(Uint8 _start, Uint8 _end, float _pos, TwerpType _type = TWERP_LINEAR, bool _looped = false, float _opt1 = Twerp_Undefined, float _opt2 = Twerp_Undefined);
 
-    struct TwerpPropertyBase
-    {
-        float time;
-        float timeElapsed;
-        TwerpType type;
-        bool looped;
-        float opt1;
-        float opt2;
-
-        TwerpPropertyBase() : time(0.0f), timeElapsed(0.0f), type(TWERP_LINEAR), looped(false), opt1(Twerp_Undefined), opt2(Twerp_Undefined) {}
-
-        TwerpPropertyBase(float _time, float _timeElapsed, TwerpType _type = TWERP_LINEAR, bool _looped = false, float _opt1 = Twerp_Undefined, float _opt2 = Twerp_Undefined)
-            : time(_time), timeElapsed(_timeElapsed), type(_type), looped(_looped), opt1(_opt1), opt2(_opt2) {}
-    };
-
-    struct TwerpPropertyFloat : public TwerpPropertyBase
-    {
-        float start;
-        float end;
-        float *value;
-
-        TwerpPropertyFloat(float *value) : value(value) {}
-
-        TwerpPropertyFloat(float *_value, float _start, float _end, float _time, float _timeElapsed, TwerpType _type = TWERP_LINEAR, bool _looped = false, float _opt1 = Twerp_Undefined, float _opt2 = Twerp_Undefined)
-            : TwerpPropertyBase(_time, _timeElapsed, _type, _looped, _opt1, _opt2), start(_start), end(_end), value(_value) {}
-    };
-    struct TwerpPropertyInt : public TwerpPropertyBase
-    {
-        int start;
-        int end;
-        int *value;
-
-        TwerpPropertyInt(int *value) : value(value) {}
-
-        TwerpPropertyInt(int *_value, int _start, int _end, float _time, float _timeElapsed, TwerpType _type = TWERP_LINEAR, bool _looped = false, float _opt1 = Twerp_Undefined, float _opt2 = Twerp_Undefined)
-            : TwerpPropertyBase(_time, _timeElapsed, _type, _looped, _opt1, _opt2), start(_start), end(_end), value(_value) {}
-    };
-    struct TwerpPropertyUint8 : public TwerpPropertyBase
-    {
-        Uint8 start;
-        Uint8 end;
-        Uint8 *value;
-
-        TwerpPropertyUint8(Uint8 *value) : value(value) {}
-
-        TwerpPropertyUint8(Uint8 *_value, Uint8 _start, Uint8 _end, float _time, float _timeElapsed, TwerpType _type = TWERP_LINEAR, bool _looped = false, float _opt1 = Twerp_Undefined, float _opt2 = Twerp_Undefined)
-            : TwerpPropertyBase(_time, _timeElapsed, _type, _looped, _opt1, _opt2), start(_start), end(_end), value(_value) {}
-    };
+    // Fill in the default options for a curve type
+    /// @param opt1 The first option, replaced if it's Twerp_Undefined
+    /// @param opt2 The second option, replaced if it's Twerp_Undefined
+    void TwerpDefaultOptions(TwerpType type, float &opt1, float &opt2);
+    // Get how far along a curve a position is, from 0 at the start to 1 at the end
+    // Some curves overshoot past 0 or 1 on the way
+    /// @param pos The position on the curve, from 0 to 1
+    /// @param opt1 The curve's first option, already filled in by TwerpDefaultOptions()
+    /// @param opt2 The curve's second option, already filled in by TwerpDefaultOptions()
+    float TwerpEase(TwerpType type, float pos, float opt1, float opt2);
+    // Ease many positions along the same curve, in place
+    // The curve is picked once for the whole batch, so the loop can be vectorized
+    /// @param pos The positions on the curve, from 0 to 1
+    /// @param opt1 Each position's first option, already filled in
+    /// @param opt2 Each position's second option, already filled in
+    void TwerpEaseBatch(TwerpType type, float *pos, const float *opt1, const float *opt2, size_t count);
+
+    // Identifies a running twerp coroutine
+    // An ID stops working once its coroutine finishes or is stopped
+    typedef Uint32 TwerpId;
+    // An ID that no coroutine has
+    const TwerpId kNoTwerp = 0;
 
     // Twerp (lerp) function, but make it a coroutine!
+    // Twerping a value that's already being twerped replaces the old coroutine
+    // The coroutine stops when the actor is removed, so the value should belong to the actor
     /// @param actor The actor to twerp (use `this` in a class)
     /// @param value A reference to the value to twerp
     /// @param start The start value
@@ -115,16 +95,34 @@ namespace junebug
     /// @param time The time to twerp across in seconds
     /// @param type The type of curve to use
     /// @param looped OPTIONAL Whether or not the curve is looped
-    /// @return The coroutine ID, or -1 if the coroutine could not be created
-    void TwerpAsync(class Actor *actor, float &value, float start, float end, float time, TwerpType type = TWERP_LINEAR, bool looped = false, float opt1 = Twerp_Undefined, float opt2 = Twerp_Undefined);
-    void TwerpAsync(class Actor *actor, int &value, int start, int end, float time, TwerpType type = TWERP_LINEAR, bool looped = false, float opt1 = Twerp_Undefined, float opt2 = Twerp_Undefined);
-    void TwerpAsync(class Actor *actor, Uint8 &value, Uint8 start, Uint8 end, float time, TwerpType type = TWERP_LINEAR, bool looped = false, float opt1 = Twerp_Undefined, float opt2 = Twerp_Undefined);
-
+    /// @return The coroutine ID, or kNoTwerp if the coroutine could not be created
+    TwerpId TwerpAsync(class Actor *actor, float &value, float start, float end, float time, TwerpType type = TWERP_LINEAR, bool looped = false, float opt1 = Twerp_Undefined, float opt2 = Twerp_Undefined);
+    TwerpId TwerpAsync(class Actor *actor, int &value, int start, int end, float time, TwerpType type = TWERP_LINEAR, bool looped = false, float opt1 = Twerp_Undefined, float opt2 = Twerp_Undefined);
+    TwerpId TwerpAsync(class Actor *actor, Uint8 &value, Uint8 start, Uint8 end, float time, TwerpType type = TWERP_LINEAR, bool looped = false, float opt1 = Twerp_Undefined, float opt2 = Twerp_Undefined);
+    TwerpId TwerpAsync(class Actor *actor, Vec2<float> &value, Vec2<float> start, Vec2<float> end, float time, TwerpType type = TWERP_LINEAR, bool looped = false, float opt1 = Twerp_Undefined, float opt2 = Twerp_Undefined);
+    TwerpId TwerpAsync(class Actor *actor, Color &value, Color start, Color end, float time, TwerpType type = TWERP_LINEAR, bool looped = false, float opt1 = Twerp_Undefined, float opt2 = Twerp_Undefined);
+    // Twerp an actor's position as a coroutine
+    // The position is set through VisualActor::SetPosition(), so nothing else about the actor has to be exposed
+    /// @param actor The actor to move
+    /// @return The coroutine ID, or kNoTwerp if the coroutine could not be created
+    TwerpId TwerpPositionAsync(class VisualActor *actor, Vec2<float> start, Vec2<float> end, float time, TwerpType type = TWERP_LINEAR, bool looped = false, float opt1 = Twerp_Undefined, float opt2 = Twerp_Undefined);
+
+    // Pause or resume a twerp coroutine
+    /// @param forceState -1 to toggle, 0 to pause, 1 to resume
+    /// @return True if the coroutine was found
     bool ToggleTwerpAsync(class Actor *actor, float &value, int forceState = -1);
     bool ToggleTwerpAsync(class Actor *actor, int &value, int forceState = -1);
     bool ToggleTwerpAsync(class Actor *actor, Uint8 &value, int forceState = -1);
+    bool ToggleTwerpAsync(class Actor *actor, Vec2<float> &value, int forceState = -1);
+    bool ToggleTwerpAsync(class Actor *actor, Color &value, int forceState = -1);
+    bool ToggleTwerpAsync(TwerpId id, int forceState = -1);
 
+    // Stop a twerp coroutine, leaving the value where it is
+    /// @return True if the coroutine was found
     bool StopTwerpAsync(class Actor *actor, float &value);
     bool StopTwerpAsync(class Actor *actor, int &value);
     bool StopTwerpAsync(class Actor *actor, Uint8 &value);
+    bool StopTwerpAsync(class Actor *actor, Vec2<float> &value);
+    bool StopTwerpAsync(class Actor *actor, Color &value);
+    bool StopTwerpAsync(TwerpId id);
 };
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+#ifndef NAMESPACES
+#define NAMESPACES
+#endif
+
+#include "Twerp.h"
+#include "Pool.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace junebug
+{
+    class Actor;
+    class VisualActor;
+
+    // Runs every twerp coroutine
+    // Coroutines are grouped into batches by value type and curve, and each batch keeps its data in parallel arrays
+    // A batch is updated with one tight loop per step, and finished coroutines are removed by swapping in the last one
+    class TwerpEngine
+    {
+    public:
+        TwerpEngine();
+        ~TwerpEngine();
+        TwerpEngine(const TwerpEngine &) = delete;
+        TwerpEngine &operator=(const TwerpEngine &) = delete;
+
+        // Start twerping a value owned by an actor
+        // A value that's already being twerped has its old coroutine replaced
+        /// @param owner The actor the value belongs to; the coroutine stops when it's removed
+        /// @returns The coroutine's ID, or kNoTwerp if it finished immediately
+        TwerpId Add(Actor *owner, float &value, float start, float end, float time, TwerpType type, bool looped, float opt1, float opt2);
+        TwerpId Add(Actor *owner, int &value, int start, int end, float time, TwerpType type, bool looped, float opt1, float opt2);
+        TwerpId Add(Actor *owner, Uint8 &value, Uint8 start, Uint8 end, float time, TwerpType type, bool looped, float opt1, float opt2);
+        TwerpId Add(Actor *owner, Vec2<float> &value, Vec2<float> start, Vec2<float> end, float time, TwerpType type, bool looped, float opt1, float opt2);
+        TwerpId Add(Actor *owner, Color &value, Color start, Color end, float time, TwerpType type, bool looped, float opt1, float opt2);
+        // Start twerping an actor's position
+        /// @returns The coroutine's ID, or kNoTwerp if it finished immediately
+        TwerpId AddPosition(VisualActor *actor, Vec2<float> start, Vec2<float> end, float time, TwerpType type, bool looped, float opt1, float opt2);
+
+        // Pause or resume a coroutine
+        /// @param forceState -1 to toggle, 0 to pause, 1 to resume
+        /// @returns True if the coroutine was found
+        bool Toggle(TwerpId id, int forceState = -1);
+        // Pause or resume the coroutine twerping a value
+        /// @param owner The actor the value belongs to
+        template <typename T>
+        bool Toggle(Actor *owner, T &value, int forceState = -1) { return Toggle(owner, &value, KindOf(value), forceState); }
+        // Stop a coroutine, leaving its value where it is
+        /// @returns True if the coroutine was found
+        bool Stop(TwerpId id);
+        // Stop the coroutine twerping a value
+        /// @param owner The actor the value belongs to
+        template <typename T>
+        bool Stop(Actor *owner, T &value) { return Stop(owner, &value, KindOf(value)); }
+        // Stop every coroutine owned by an actor
+        void RemoveOwner(Actor *owner);
+
+        // Advance every running coroutine and write the new values
+        void Update(float dt);
+
+        // The number of running coroutines
+        size_t Count() const { return mCount; }
+
+    private:
+        // The value types a batch can twerp
+        enum Kind
+        {
+            KIND_FLOAT,
+            KIND_INT,
+            KIND_UINT8,
+            KIND_VEC2,
+            KIND_COLOR,
+            KIND_POSITION,
+            KIND_COUNT
+        };
+        static Kind KindOf(const float &) { return KIND_FLOAT; }
+        static Kind KindOf(const int &) { return KIND_INT; }
+        static Kind KindOf(const Uint8 &) { return KIND_UINT8; }
+        static Kind KindOf(const Vec2<float> &) { return KIND_VEC2; }
+        static Kind KindOf(const Color &) { return KIND_COLOR; }
+
+        // A twerped value, told apart by kind since a struct and its first member share an address
+        struct TargetKey
+        {
+            const void *value = nullptr;
+            int kind = 0;
+            bool operator==(const TargetKey &other) const { return value == other.value && kind == other.kind; }
+        };
+        struct TargetKeyHash
+        {
+            size_t operator()(const TargetKey &key) const { return std::hash<const void *>()(key.value) ^ (size_t)key.kind; }
+        };
+
+        struct Batch;
+        template <typename T, typename Target>
+        struct TypedBatch;
+
+        // Where a coroutine is stored, looked up by its ID
+        struct Record
+        {
+            uint32_t batch = 0;
+            uint32_t index = 0;
+            uint32_t generation = 0;
+            bool active = false;
+            Actor *owner = nullptr;
+            // The value being twerped, so a value only has one coroutine at a time
+            TargetKey target;
+        };
+
+        template <typename T, typename Target>
+        TwerpId AddTyped(int kind, Actor *owner, const void *key, Target target, T start, T end, float time, TwerpType type, bool looped, float opt1, float opt2);
+        Record *FindRecord(TwerpId id);
+        bool Toggle(Record &record, int forceState);
+        bool Toggle(Actor *owner, const void *value, int kind, int forceState);
+        bool Stop(Actor *owner, const void *value, int kind);
+        // Remove the coroutine at an index of a batch, moving the batch's last coroutine into its place
+        void RemoveAt(Batch &batch, uint32_t index);
+
+        // Every value type's batches for every curve, created the first time they're used
+        std::vector<std::unique_ptr<Batch>> mBatches;
+        std::vector<Record> mRecords;
+        std::vector<uint32_t> mFreeRecords;
+        // The coroutine for each twerped value
+        std::unordered_map<TargetKey, TwerpId, TargetKeyHash> mTargets;
+        // Each actor's coroutines
+        // Actors come and go constantly, so their entries come from the pools
+        typedef std::vector<TwerpId, PoolAllocator<TwerpId>> OwnedList;
+        std::unordered_map<Actor *, OwnedList, std::hash<Actor *>, std::equal_to<Actor *>, PoolAllocator<std::pair<Actor *const, OwnedList>>> mOwned;
+        size_t mCount = 0;
+    };
+}
\ No newline at end of file
@@ -32,15 +32,29 @@ namespace junebug
 
         virtual void UpdateCollPositions(Vec2<float> offset = Vec2<float>::Zero){};
 
+        // Get the world space bounding box of this collider
+        /// @param topLeft The top left corner of the box
+        /// @param bottomRight The bottom right corner of the box
+        /// @returns False if the collider has no finite bounds
+        virtual bool GetBounds(Vec2<float> &topLeft, Vec2<float> &bottomRight) const { return false; };
+
         virtual void Draw(){};
 
     protected:
         friend class TileCollider;
+        friend class SpatialHash;
         VisualActor *mOwner;
 
         std::string mLayer;
         CollType mType = CollType::None;
 
         void UpdateCollEntry(bool initial);
+
+        // Broadphase bookkeeping, managed by the layer's SpatialHash
+        Vec2<int> mGridMin, mGridMax;
+        bool mGridBounded = false;
+        unsigned int mGridStamp = 0, mGridOrder = 0;
+        // Where the collider is in the grid's collider list and unbounded list, so it can be removed without a search
+        size_t mGridIndex = 0, mGridUnboundedIndex = 0;
     };
 };
\ No newline at end of file
@@ -52,21 +52,26 @@ namespace junebug
             mOffscreen = IsOffscreen();
         };
 
+        // In a component pass, the bounds check runs across the worker threads and only the callbacks run on the main thread
+        static constexpr UpdateAccess kPrepareAccess{ACCESS_OWNER | ACCESS_GAME, ACCESS_OWNER};
+        void PrepareUpdate(float dt)
+        {
+            mNextOffscreen = IsOffscreen();
+            mPrepared = true;
+        }
+
         void Update(float dt) override
         {
-            if (mOffscreen)
-            {
-                if (!IsOffscreen())
-                {
-                    mOffscreen = false;
-                    mOnEnter();
-                }
-            }
-            else if (IsOffscreen())
-            {
-                mOffscreen = true;
+            bool offscreen = mPrepared ? mNextOffscreen : IsOffscreen();
+            mPrepared = false;
+            if (offscreen == mOffscreen)
+                return;
+
+            mOffscreen = offscreen;
+            if (offscreen)
                 mOnExit();
-            }
+            else
+                mOnEnter();
         }
 
         bool IsOffscreen()
@@ -98,6 +103,8 @@ namespace junebug
 
         bool mOffscreen = false;
         bool mUseCamera = false;
+        // The result of PrepareUpdate(), if it ran this frame
+        bool mNextOffscreen = false, mPrepared = false;
 
         // Lambda functions to be called when the actor enters or exits the screen
         std::function<void()> mOnEnter = []() {};
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "components/Collider.h"
+#include "Rendering.h"
 
 namespace junebug
 {
@@ -18,11 +19,27 @@ namespace junebug
 
         void LoadVertices(const VerticesPtr vertices);
 
+        // Check whether the bounding boxes of two polygons overlap
+        // Cheap rejection test to run before CheckAxes()
+        bool BoundsOverlap(const PolygonCollisionBounds &other, Vec2<float> offset = Vec2<float>::Zero, Vec2<float> otherOffset = Vec2<float>::Zero) const;
+
         bool CheckAxes(const PolygonCollisionBounds &other, float &overlap, Vec2<float> &minAxis, Vec2<float> offset = Vec2<float>::Zero, Vec2<float> otherOffset = Vec2<float>::Zero);
 
         Vec2<float> Project(Vec2<float> &axis, Vec2<float> &offset) const;
 
         void UpdateWorldVertices(const Vec2<float> &pos, float rot, const Vec2<float> &scale, const Vec2<int> &origin);
+
+    private:
+        // Vertices rotated and scaled around the origin, before translation
+        // Only rebuilt when the rotation, scale, origin or source vertices change
+        Vertices localVertices;
+        Vec2<float> localTopLeft, localBottomRight;
+
+        // The transform the world vertices were last built with
+        Vec2<float> cachedPos, cachedScale;
+        Vec2<int> cachedOrigin;
+        float cachedRot = 0.0f;
+        bool dirty = true;
     };
 
     class PolygonCollider : public Collider
@@ -30,6 +47,9 @@ namespace junebug
     public:
         PolygonCollider(class VisualActor *owner, std::string layer = "");
 
+        // In a component pass, the vertices are transformed across the worker threads before the broadphase is updated on the main thread
+        static constexpr UpdateAccess kPrepareAccess{ACCESS_OWNER | ACCESS_GAME, ACCESS_OWNER};
+        void PrepareUpdate(float dt);
         void Update(float dt) override;
 
         bool Intersects(Collider *other) override;
@@ -37,6 +57,8 @@ namespace junebug
 
         void UpdateCollPositions(Vec2<float> offset = Vec2<float>::Zero) override;
 
+        bool GetBounds(Vec2<float> &topLeft, Vec2<float> &bottomRight) const override;
+
         void Draw() override;
 
         const PolygonCollisionBounds &GetCollBounds() const { return mCollBounds; }
@@ -45,6 +67,6 @@ namespace junebug
         friend class TileCollider;
 
         PolygonCollisionBounds mCollBounds;
-        std::string mParentSprite{""};
+        SpriteHandle mParentSprite;
     };
 };
\ No newline at end of file
@@ -61,7 +61,10 @@ namespace junebug
 
         void PhysicsUpdate(float dt);
         void CheckCollisions();
+        void CheckCollisionLayer(const std::string &layer, const std::vector<class Collider *> &collisions);
         void CheckCollisionList(const std::vector<class Collider *> &collisions);
+        // Broadphase results, kept around to avoid reallocating every frame
+        std::vector<class Collider *> mCandidates;
 
         std::vector<std::string> mPhysLayers;
     };
@@ -24,13 +24,35 @@ namespace junebug
 
         void Draw() override;
 
+        // Mark a tile as changed so its merged colliders are rebuilt on the next update
+        /// @param tile The tile position that changed
+        void MarkTileDirty(Vec2<int> tile);
+        // Rebuild every merged collider on the next update
+        void MarkAllDirty();
+
+        // A rectangle of square tiles that collide as one shape
+        struct MergedRect
+        {
+            Vec2<int> pos, size;
+        };
+
     private:
         class Tileset *mOwner;
 
         std::string mParentSprite{""};
-        std::vector<PolygonCollisionBounds> mColliders, mMergedColliders;
-        std::vector<VerticesPtr> mMergedColliderVertices;
+        std::vector<PolygonCollisionBounds> mColliders;
+
+        // Merged rectangles are grouped into horizontal bands of rows, so an edit only rebuilds its own band
+        static const int kBandHeight = 16;
+        std::vector<std::vector<MergedRect>> mMergedBands;
+        std::vector<bool> mDirtyBands;
+        bool mAnyBandDirty = true;
+        Vec2<int> mMergedGridSize{-1, -1};
+        // Scratch storage reused between rebuilds
+        std::vector<bool> mVisited;
+        Vertices mDrawVertices;
 
         void UpdateMergedColliders();
+        void RebuildBand(int band);
     };
 }
\ No newline at end of file
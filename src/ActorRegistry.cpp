@@ -0,0 +1,96 @@
+#include "ActorRegistry.h"
+#include "Actors.h"
+
+using namespace junebug;
+
+void ActorRegistry::Add(Actor *actor)
+{
+    actor->mRegistryPending = (int)mPending.size();
+    mPending.push_back(actor);
+    if (!actor->mId.empty())
+        mIds.emplace(actor->mId, actor);
+}
+
+void ActorRegistry::Remove(Actor *actor)
+{
+    if (actor->mRegistryPending >= 0)
+    {
+        mPending[actor->mRegistryPending] = nullptr;
+        actor->mRegistryPending = -1;
+    }
+
+    for (const ActorRegistrySlot &slot : actor->mRegistrySlots)
+        mLists[slot.list]->Clear(slot.index);
+    actor->mRegistrySlots.clear();
+
+    if (!actor->mId.empty())
+    {
+        auto range = mIds.equal_range(actor->mId);
+        for (auto it = range.first; it != range.second; it++)
+        {
+            if (it->second == actor)
+            {
+                mIds.erase(it);
+                break;
+            }
+        }
+    }
+}
+
+void ActorRegistry::SetId(Actor *actor, const std::string &id)
+{
+    if (actor->mId == id)
+        return;
+
+    auto range = mIds.equal_range(actor->mId);
+    for (auto it = range.first; it != range.second; it++)
+    {
+        if (it->second == actor)
+        {
+            mIds.erase(it);
+            break;
+        }
+    }
+
+    actor->mId = id;
+    if (!id.empty())
+        mIds.emplace(id, actor);
+}
+
+void ActorRegistry::Flush()
+{
+    if (mPending.empty())
+        return;
+
+    for (Actor *actor : mPending)
+    {
+        if (!actor)
+            continue;
+        actor->mRegistryPending = -1;
+        for (auto &list : mLists)
+            list->TryAdd(actor);
+    }
+    mPending.clear();
+}
+
+bool ActorRegistry::IsPending(Actor *actor)
+{
+    return actor->mRegistryPending >= 0;
+}
+
+void ActorRegistry::AddSlot(Actor *actor, uint32_t list, uint32_t index)
+{
+    actor->mRegistrySlots.push_back({list, index});
+}
+
+void ActorRegistry::MoveSlot(Actor *actor, uint32_t list, uint32_t index)
+{
+    for (ActorRegistrySlot &slot : actor->mRegistrySlots)
+    {
+        if (slot.list == list)
+        {
+            slot.index = index;
+            return;
+        }
+    }
+}
\ No newline at end of file
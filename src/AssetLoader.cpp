@@ -0,0 +1,248 @@
+#include "AssetLoader.h"
+#include "Game.h"
+#include "Sprite.h"
+#include "Files.h"
+
+#include "SDL2/SDL_image.h"
+#include <filesystem>
+#include <chrono>
+namespace fs = std::filesystem;
+
+using namespace junebug;
+
+AssetLoader::~AssetLoader()
+{
+    Stop();
+}
+
+void AssetLoader::Start(int threadCount)
+{
+    Stop();
+
+#ifndef __EMSCRIPTEN__
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = false;
+    for (int i = 0; i < threadCount; i++)
+        mWorkers.emplace_back(&AssetLoader::WorkerLoop, this);
+#endif
+}
+
+void AssetLoader::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mJobReady.notify_all();
+    for (std::thread &worker : mWorkers)
+        worker.join();
+    mWorkers.clear();
+
+    for (auto &job : mPending)
+        FreeSurfaces(*job);
+    for (auto &job : mDecoded)
+        FreeSurfaces(*job);
+    mPending.clear();
+    mDecoded.clear();
+    mInFlight = 0;
+
+    mQueued.clear();
+    mGroups.clear();
+    mTotal = LoadProgress();
+}
+
+void AssetLoader::PreloadSprite(const std::string &path, const std::string &group)
+{
+    Game *game = Game::Get();
+    if (path.empty() || !game || game->FindSprite(path).IsValid() || !mQueued.insert(path).second)
+        return;
+
+    mTotal.total++;
+    mGroups[group].total++;
+
+    std::unique_ptr<Job> job(new Job());
+    job->path = path;
+    job->group = group;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPending.push_back(std::move(job));
+    }
+    mJobReady.notify_one();
+}
+
+void AssetLoader::Pump(float budget)
+{
+    if (mQueued.empty())
+        return;
+
+    auto start = std::chrono::steady_clock::now();
+    auto limit = std::chrono::duration<float, std::milli>(budget);
+    do
+    {
+        std::unique_ptr<Job> job;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (!mDecoded.empty())
+            {
+                job = std::move(mDecoded.front());
+                mDecoded.pop_front();
+            }
+            else if (mWorkers.empty() && !mPending.empty())
+            {
+                job = std::move(mPending.front());
+                mPending.pop_front();
+            }
+        }
+        if (!job)
+            break;
+
+        if (!job->decoded)
+            Decode(*job);
+        Upload(*job);
+    } while (std::chrono::steady_clock::now() - start < limit);
+}
+
+void AssetLoader::Finish(const std::string &group)
+{
+    while (IsLoading(group))
+    {
+        std::unique_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            if (mWorkers.empty() || mPending.size() + mInFlight == 0)
+            {
+                if (!mDecoded.empty())
+                {
+                    job = std::move(mDecoded.front());
+                    mDecoded.pop_front();
+                }
+                else if (!mPending.empty())
+                {
+                    job = std::move(mPending.front());
+                    mPending.pop_front();
+                }
+                else
+                    return;
+            }
+            else
+            {
+                mJobDone.wait(lock, [this]
+                              { return !mDecoded.empty(); });
+                job = std::move(mDecoded.front());
+                mDecoded.pop_front();
+            }
+        }
+
+        if (!job->decoded)
+            Decode(*job);
+        Upload(*job);
+    }
+}
+
+LoadProgress AssetLoader::GetProgress(const std::string &group) const
+{
+    if (group == "")
+        return mTotal;
+    auto it = mGroups.find(group);
+    if (it == mGroups.end())
+        return LoadProgress();
+    return it->second;
+}
+
+void AssetLoader::WorkerLoop()
+{
+    while (true)
+    {
+        std::unique_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mJobReady.wait(lock, [this]
+                           { return mStopping || !mPending.empty(); });
+            if (mStopping)
+                return;
+            job = std::move(mPending.front());
+            mPending.pop_front();
+            mInFlight++;
+        }
+
+        Decode(*job);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mInFlight--;
+            if (mStopping)
+            {
+                FreeSurfaces(*job);
+                return;
+            }
+            mDecoded.push_back(std::move(job));
+        }
+        mJobDone.notify_all();
+    }
+}
+
+void AssetLoader::Decode(Job &job)
+{
+    // Only touches the disk and the job itself, so it's safe to run on a worker
+    std::vector<std::string> files;
+    std::error_code ec;
+    if (fs::is_directory(job.path, ec))
+    {
+        job.isFolder = true;
+        job.metadata = std::make_unique<Json>(job.path + "/" + StringSplitEntry(job.path, "/", -1) + ".json");
+        if (job.metadata->IsValid())
+        {
+            for (auto &frame : Json::GetStringArray(job.metadata.get(), "frames"))
+                files.push_back(job.path + "/" + frame);
+        }
+    }
+    else
+        files.push_back(job.path);
+
+    for (auto &file : files)
+    {
+        if (fs::is_regular_file(file, ec))
+            job.surfaces.push_back(std::make_pair(file, IMG_Load(file.c_str())));
+    }
+    job.decoded = true;
+}
+
+void AssetLoader::Upload(Job &job)
+{
+    Game *game = Game::Get();
+
+    // The sprite may have been loaded synchronously while this job was in flight
+    if (game && !game->FindSprite(job.path).IsValid())
+    {
+        for (auto &surface : job.surfaces)
+        {
+            TextureRegion region;
+            if (surface.second && !game->FindTextureRegion(surface.first, region))
+                game->AddTextureSurface(surface.first, surface.second);
+        }
+
+        std::shared_ptr<Sprite> sprite(new Sprite());
+        bool loaded = job.isFolder ? sprite->LoadMetadata(job.path, *job.metadata) : sprite->LoadTextureFile(job.path);
+        if (!loaded)
+        {
+            PrintLog("Failed to preload sprite", job.path);
+            sprite.reset();
+        }
+        game->AddSprite(job.path, sprite);
+    }
+    FreeSurfaces(job);
+
+    mQueued.erase(job.path);
+    mTotal.loaded++;
+    mGroups[job.group].loaded++;
+}
+
+void AssetLoader::FreeSurfaces(Job &job)
+{
+    for (auto &surface : job.surfaces)
+    {
+        if (surface.second)
+            SDL_FreeSurface(surface.second);
+    }
+    job.surfaces.clear();
+}
\ No newline at end of file
@@ -87,9 +87,8 @@ SDL_Texture *Camera::Render(SDL_Renderer *renderer, float dt)
 
     game->SetActiveCamera(this);
     for (Actor *actor : game->GetAllActors())
-    {
         actor->Draw();
-    }
+    game->FlushRenderQueue();
 
     if (game->GetOptions().drawColliders)
     {
@@ -0,0 +1,60 @@
+#include "ComponentPass.h"
+#include "Actors.h"
+
+using namespace junebug;
+
+void junebug::__RemoveFromComponentPass__(ComponentPass *pass, uint32_t index)
+{
+    pass->Remove(index);
+}
+
+ComponentPass::~ComponentPass()
+{
+    // Components that outlive the pass go back to being updated by their actor
+    for (Component<> *comp : mComponents)
+    {
+        if (comp)
+            comp->mPass = nullptr;
+    }
+}
+
+void ComponentPass::Add(Component<> *comp)
+{
+    for (Component<> *other : comp->mOwner->mComponents)
+    {
+        if (other->mPass == this)
+            mSharedOwners = true;
+    }
+
+    comp->mPass = this;
+    comp->mPassIndex = (uint32_t)mComponents.size();
+    mComponents.push_back(comp);
+}
+
+void ComponentPass::Remove(uint32_t index)
+{
+    mComponents[index] = nullptr;
+    mHoles++;
+}
+
+void ComponentPass::Compact()
+{
+    if (mHoles == 0)
+        return;
+
+    size_t kept = 0;
+    for (Component<> *comp : mComponents)
+    {
+        if (!comp)
+            continue;
+        comp->mPassIndex = (uint32_t)kept;
+        mComponents[kept++] = comp;
+    }
+    mComponents.resize(kept);
+    mHoles = 0;
+}
+
+bool ComponentPass::IsActive(Component<> *comp)
+{
+    return comp->mOwner->GetState() == ActorState::Active;
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "FramePacer.h"
+#include "MathLib.h"
+
+#include <thread>
+#include <cmath>
+#include <algorithm>
+
+using namespace junebug;
+using namespace std::chrono;
+
+// Sleeps shorter than this aren't worth the wake-up delay
+static const double kMinSleep = 0.0005;
+// How quickly the oversleep estimate follows new samples
+static const double kOversleepRate = 0.1;
+
+FramePacer::FramePacer()
+{
+    SetTargetFps(60.0);
+    mHistory.reserve(kHistorySize);
+    Reset();
+}
+
+void FramePacer::Reset()
+{
+    mFrameStart = Clock::now();
+    mNextFrame = mFrameStart + mTarget;
+    mSecondStart = mFrameStart;
+    mFramesThisSecond = 0;
+}
+
+void FramePacer::SetTargetFps(double fps)
+{
+    mTarget = duration_cast<Clock::duration>(duration<double>(1.0 / Max(fps, 1.0)));
+}
+
+void FramePacer::SetOversleepEstimate(double ms)
+{
+    mOversleepMean = Max(ms, 0.0) / 1000.0;
+    mOversleepVar = 0.0;
+}
+
+float FramePacer::Wait()
+{
+    Clock::time_point now = Clock::now();
+    float workTime = (float)duration<double>(now - mFrameStart).count();
+
+#ifndef __EMSCRIPTEN__
+    // The browser already paces the main loop, so only wait on native platforms
+    if (mSleepEnabled)
+        SleepUntil(mNextFrame);
+
+    do
+    {
+        now = Clock::now();
+    } while (now < mNextFrame);
+#endif
+
+    float frameTime = (float)duration<double>(now - mFrameStart).count();
+    mFrameStart = now;
+
+    // Keep a steady cadence, but don't try to catch up after a long frame
+    mNextFrame += mTarget;
+    if (mNextFrame <= now)
+        mNextFrame = now + mTarget;
+
+    UpdateStats(frameTime, workTime, now);
+    return frameTime;
+}
+
+double FramePacer::GetSleepMargin() const
+{
+    return mOversleepMean + 2.0 * std::sqrt(mOversleepVar);
+}
+
+void FramePacer::SleepUntil(Clock::time_point deadline)
+{
+    while (true)
+    {
+        double remaining = duration<double>(deadline - Clock::now()).count() - GetSleepMargin();
+        if (remaining < kMinSleep)
+            break;
+
+        // Sleep for half of what's left, so each slice is shorter and later slices can correct for earlier oversleeps
+        double request = Max(remaining * 0.5, kMinSleep);
+        Clock::time_point before = Clock::now();
+        std::this_thread::sleep_for(duration<double>(request));
+        double slept = duration<double>(Clock::now() - before).count();
+        AddOversleepSample(slept - request);
+    }
+}
+
+void FramePacer::AddOversleepSample(double sample)
+{
+    // Ignore outliers like the process being suspended, which would ruin the estimate
+    sample = Clamp(sample, 0.0, 0.02);
+
+    double diff = sample - mOversleepMean;
+    mOversleepMean += kOversleepRate * diff;
+    mOversleepVar = (1.0 - kOversleepRate) * (mOversleepVar + kOversleepRate * diff * diff);
+}
+
+void FramePacer::UpdateStats(float frameTime, float workTime, Clock::time_point now)
+{
+    if ((int)mHistory.size() < kHistorySize)
+        mHistory.push_back(frameTime);
+    else
+        mHistory[mHistoryIndex] = frameTime;
+    mHistoryIndex = (mHistoryIndex + 1) % kHistorySize;
+
+    mStats.frameTime = frameTime;
+    mStats.workTime = workTime;
+    mStats.oversleep = (float)mOversleepMean;
+
+    float total = 0.0f;
+    mStats.minFrameTime = mHistory[0];
+    mStats.maxFrameTime = mHistory[0];
+    for (float time : mHistory)
+    {
+        total += time;
+        mStats.minFrameTime = Min(mStats.minFrameTime, time);
+        mStats.maxFrameTime = Max(mStats.maxFrameTime, time);
+    }
+    mStats.averageFrameTime = total / mHistory.size();
+
+    mFramesThisSecond++;
+    if (now - mSecondStart >= seconds(1))
+    {
+        mStats.fps = mFramesThisSecond;
+        mFramesThisSecond = 0;
+        mSecondStart = now;
+    }
+}
\ No newline at end of file
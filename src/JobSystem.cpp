@@ -0,0 +1,134 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+using namespace junebug;
+
+JobSystem::~JobSystem()
+{
+    Stop();
+}
+
+void JobSystem::Start(int threadCount)
+{
+    Stop();
+
+#ifndef __EMSCRIPTEN__
+    threadCount = std::max(threadCount, 0);
+    mQueueCount = threadCount + 1;
+    mQueues.reset(new Queue[mQueueCount]);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = false;
+    for (int i = 0; i < threadCount; i++)
+        mWorkers.emplace_back(&JobSystem::WorkerLoop, this, i);
+#endif
+}
+
+void JobSystem::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWake.notify_all();
+    for (std::thread &worker : mWorkers)
+        worker.join();
+    mWorkers.clear();
+    mQueues.reset();
+    mQueueCount = 0;
+}
+
+void JobSystem::ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t, size_t)> &func)
+{
+    if (count == 0)
+        return;
+    batchSize = std::max(batchSize, (size_t)1);
+    size_t numBatches = (count + batchSize - 1) / batchSize;
+    if (mWorkers.empty() || numBatches == 1)
+    {
+        func(0, count);
+        return;
+    }
+
+    mFunc = &func;
+    mCount = count;
+    mBatchSize = batchSize;
+    mRemaining.store(numBatches, std::memory_order_relaxed);
+
+    // Give each thread an even, contiguous share
+    size_t first = 0;
+    for (int i = 0; i < mQueueCount; i++)
+    {
+        size_t share = numBatches / mQueueCount + ((size_t)i < numBatches % mQueueCount ? 1 : 0);
+        std::lock_guard<std::mutex> lock(mQueues[i].mutex);
+        mQueues[i].begin = first;
+        mQueues[i].end = first + share;
+        first += share;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mGeneration++;
+    }
+    mWake.notify_all();
+
+    // The calling thread takes the last share, then helps with the rest
+    RunBatches(mQueueCount - 1);
+    while (mRemaining.load(std::memory_order_acquire) > 0)
+        std::this_thread::yield();
+    mFunc = nullptr;
+}
+
+void JobSystem::WorkerLoop(int index)
+{
+    unsigned int generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWake.wait(lock, [&]
+                       { return mStopping || mGeneration != generation; });
+            if (mStopping)
+                return;
+            generation = mGeneration;
+        }
+        RunBatches(index);
+    }
+}
+
+void JobSystem::RunBatches(int index)
+{
+    size_t batch;
+    while (PopBatch(index, batch) || StealBatch(index, batch))
+    {
+        size_t begin = batch * mBatchSize;
+        (*mFunc)(begin, std::min(begin + mBatchSize, mCount));
+        mRemaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+bool JobSystem::PopBatch(int index, size_t &batch)
+{
+    Queue &queue = mQueues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.begin >= queue.end)
+        return false;
+    batch = queue.begin++;
+    return true;
+}
+
+bool JobSystem::StealBatch(int index, size_t &batch)
+{
+    for (int i = 1; i < mQueueCount; i++)
+    {
+        Queue &queue = mQueues[(index + i) % mQueueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.begin < queue.end)
+        {
+            batch = --queue.end;
+            return true;
+        }
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Pool.h"
+
+#include <new>
+#include <algorithm>
+
+using namespace junebug;
+
+Pool::Bucket Pool::sBuckets[Pool::kMaxBlockSize / Pool::kGranularity];
+PoolStats Pool::sStats;
+
+void *Pool::Allocate(size_t size)
+{
+    if (size > kMaxBlockSize)
+        return ::operator new(size);
+
+    size_t index = size > 0 ? (size - 1) / kGranularity : 0;
+    Bucket &bucket = sBuckets[index];
+    if (!bucket.free)
+        Refill(bucket, (index + 1) * kGranularity, 0);
+
+    Block *block = bucket.free;
+    bucket.free = block->next;
+    bucket.freeCount--;
+    sStats.blocksInUse++;
+    return block;
+}
+
+void Pool::Free(void *ptr, size_t size)
+{
+    if (!ptr)
+        return;
+    if (size > kMaxBlockSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    Bucket &bucket = sBuckets[size > 0 ? (size - 1) / kGranularity : 0];
+    Block *block = static_cast<Block *>(ptr);
+    block->next = bucket.free;
+    bucket.free = block;
+    bucket.freeCount++;
+    sStats.blocksInUse--;
+}
+
+void Pool::Reserve(size_t size, size_t count)
+{
+    if (size > kMaxBlockSize || count == 0)
+        return;
+
+    size_t index = size > 0 ? (size - 1) / kGranularity : 0;
+    Bucket &bucket = sBuckets[index];
+    if (bucket.freeCount < count)
+        Refill(bucket, (index + 1) * kGranularity, count - bucket.freeCount);
+}
+
+PoolStats Pool::GetStats()
+{
+    return sStats;
+}
+
+void Pool::Refill(Bucket &bucket, size_t blockSize, size_t count)
+{
+    // Chunks are never given back, since the blocks in them are reused for the rest of the program
+    count = std::max(count, kChunkSize / blockSize);
+    char *chunk = static_cast<char *>(::operator new(blockSize * count));
+    sStats.reservedBytes += blockSize * count;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Block *block = reinterpret_cast<Block *>(chunk + i * blockSize);
+        block->next = bucket.free;
+        bucket.free = block;
+    }
+    bucket.freeCount += count;
+}
\ No newline at end of file
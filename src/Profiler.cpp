@@ -0,0 +1,291 @@
+#include "Profiler.h"
+#include "Files.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+using namespace junebug;
+using namespace std::chrono;
+
+std::mutex Profiler::sRegistryMutex;
+
+Profiler::Profiler()
+{
+    mZones.reserve(kMaxZones);
+    mTouched.reserve(kMaxZones);
+    mEvents.resize(kEventCapacity);
+    Reset();
+}
+
+Profiler &Profiler::Get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::ZoneId Profiler::RegisterZone(const std::string &name)
+{
+    Profiler &profiler = Get();
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+
+    auto it = profiler.mZoneIds.find(name);
+    if (it != profiler.mZoneIds.end())
+        return it->second;
+
+    // The zone list never reallocates, so zones can be registered while others are being timed
+    if (profiler.mZones.size() >= kMaxZones)
+    {
+        PrintLog("Too many profiler zones; ignoring", name);
+        return kNoZone;
+    }
+
+    Zone zone;
+    zone.name = name;
+    zone.history.resize(profiler.mWindowSize);
+    zone.historyCalls.resize(profiler.mWindowSize);
+    zone.historyFrames.resize(profiler.mWindowSize);
+    profiler.mZones.push_back(std::move(zone));
+
+    ZoneId id = (ZoneId)(profiler.mZones.size() - 1);
+    profiler.mZoneIds[name] = id;
+    return id;
+}
+
+void Profiler::SetWindowSize(int frames)
+{
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+    mWindowSize = std::max(frames, 1);
+    for (Zone &zone : mZones)
+    {
+        zone.history.assign(mWindowSize, 0.0f);
+        zone.historyCalls.assign(mWindowSize, 0);
+        zone.historyFrames.assign(mWindowSize, 0);
+        zone.historyIndex = 0;
+        zone.historyCount = 0;
+    }
+}
+
+bool Profiler::BeginZone(ZoneId id)
+{
+    if (!mEnabled || id == kNoZone || mDepth >= kMaxDepth || std::this_thread::get_id() != mThread)
+        return false;
+
+    Zone &zone = mZones[id];
+    if (zone.depth < 0)
+    {
+        zone.depth = mDepth;
+        zone.parent = mDepth > 0 ? mStack[mDepth - 1].id : kNoZone;
+    }
+
+    mStack[mDepth++] = {id, Clock::now()};
+    return true;
+}
+
+void Profiler::EndZone(ZoneId id)
+{
+    // Only the main thread has a zone stack
+    if (std::this_thread::get_id() != mThread)
+        return;
+    Clock::time_point now = Clock::now();
+
+    // Zones opened inside this one but never closed are dropped with it
+    int depth = mDepth - 1;
+    while (depth >= 0 && mStack[depth].id != id)
+        depth--;
+    if (depth < 0)
+        return;
+    mDepth = depth;
+
+    const OpenZone &open = mStack[depth];
+    Zone &zone = mZones[id];
+    if (zone.frameCalls == 0)
+        mTouched.push_back(id);
+    zone.frameTime += duration<double, std::milli>(now - open.start).count();
+    zone.frameCalls++;
+
+    Event &event = mEvents[mEventHead];
+    event.id = id;
+    event.depth = (uint8_t)depth;
+    event.frame = mFrame;
+    event.start = duration_cast<nanoseconds>(open.start - mEpoch).count();
+    event.duration = duration_cast<nanoseconds>(now - open.start).count();
+    mEventHead = (mEventHead + 1) % kEventCapacity;
+    mEventCount = std::min(mEventCount + 1, kEventCapacity);
+}
+
+void Profiler::EndFrame()
+{
+    if (std::this_thread::get_id() != mThread)
+        return;
+
+    for (ZoneId id : mTouched)
+    {
+        Zone &zone = mZones[id];
+        zone.history[zone.historyIndex] = (float)zone.frameTime;
+        zone.historyCalls[zone.historyIndex] = zone.frameCalls;
+        zone.historyFrames[zone.historyIndex] = mFrame;
+        zone.historyIndex = (zone.historyIndex + 1) % (int)zone.history.size();
+        zone.historyCount = std::min(zone.historyCount + 1, (int)zone.history.size());
+
+        zone.frameTime = 0.0;
+        zone.frameCalls = 0;
+    }
+    mTouched.clear();
+
+    // Anything still open was never closed, so don't let it swallow the next frame's zones
+    mDepth = 0;
+    mFrame++;
+}
+
+void Profiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+
+    // Zone IDs are held by call sites, so registrations are kept
+    for (Zone &zone : mZones)
+    {
+        zone.parent = kNoZone;
+        zone.depth = -1;
+        zone.frameTime = 0.0;
+        zone.frameCalls = 0;
+        zone.historyIndex = 0;
+        zone.historyCount = 0;
+    }
+    mTouched.clear();
+    mDepth = 0;
+    mEventHead = 0;
+    mEventCount = 0;
+    mFrame = 0;
+    mEpoch = Clock::now();
+    mThread = std::this_thread::get_id();
+}
+
+std::vector<ZoneStats> Profiler::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(sRegistryMutex);
+
+    // Walk the zones depth-first, so each zone is listed under the zone it was first nested in
+    std::vector<std::vector<ZoneId>> children(mZones.size());
+    std::vector<ZoneId> roots;
+    for (size_t i = 0; i < mZones.size(); i++)
+    {
+        const Zone &zone = mZones[i];
+        if (zone.depth < 0)
+            continue;
+        if (zone.parent == kNoZone)
+            roots.push_back((ZoneId)i);
+        else
+            children[zone.parent].push_back((ZoneId)i);
+    }
+
+    std::vector<ZoneStats> stats;
+    std::vector<float> times;
+    std::vector<ZoneId> stack(roots.rbegin(), roots.rend());
+    while (!stack.empty())
+    {
+        ZoneId id = stack.back();
+        stack.pop_back();
+        const Zone &zone = mZones[id];
+        for (auto it = children[id].rbegin(); it != children[id].rend(); it++)
+            stack.push_back(*it);
+
+        times.clear();
+        int calls = 0;
+        for (int i = 0; i < zone.historyCount; i++)
+        {
+            if (mFrame - zone.historyFrames[i] > (uint32_t)mWindowSize)
+                continue;
+            times.push_back(zone.history[i]);
+            calls += zone.historyCalls[i];
+        }
+        if (times.empty())
+            continue;
+
+        std::sort(times.begin(), times.end());
+        ZoneStats stat;
+        stat.name = zone.name;
+        stat.depth = zone.depth;
+        stat.frames = (int)times.size();
+        stat.calls = (float)calls / times.size();
+        stat.min = times.front();
+        stat.max = times.back();
+        float total = 0.0f;
+        for (float time : times)
+            total += time;
+        stat.avg = total / times.size();
+        size_t p99 = (size_t)std::ceil(times.size() * 0.99) - 1;
+        stat.p99 = times[std::min(p99, times.size() - 1)];
+        stats.push_back(stat);
+    }
+    return stats;
+}
+
+bool Profiler::ExportTrace(const std::string &path) const
+{
+    StringBuffer buffer;
+    Writer<StringBuffer> writer(buffer);
+
+    writer.StartObject();
+    writer.Key("displayTimeUnit");
+    writer.String("ms");
+    writer.Key("traceEvents");
+    writer.StartArray();
+
+    writer.StartObject();
+    writer.Key("name");
+    writer.String("thread_name");
+    writer.Key("ph");
+    writer.String("M");
+    writer.Key("pid");
+    writer.Int(0);
+    writer.Key("tid");
+    writer.Int(0);
+    writer.Key("args");
+    writer.StartObject();
+    writer.Key("name");
+    writer.String("Main");
+    writer.EndObject();
+    writer.EndObject();
+
+    // Oldest first, as chrome://tracing expects
+    size_t first = (mEventHead + kEventCapacity - mEventCount) % kEventCapacity;
+    for (size_t i = 0; i < mEventCount; i++)
+    {
+        const Event &event = mEvents[(first + i) % kEventCapacity];
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(mZones[event.id].name.c_str());
+        writer.Key("cat");
+        writer.String("junebug");
+        writer.Key("ph");
+        writer.String("X");
+        writer.Key("ts");
+        writer.Double(event.start / 1000.0);
+        writer.Key("dur");
+        writer.Double(event.duration / 1000.0);
+        writer.Key("pid");
+        writer.Int(0);
+        writer.Key("tid");
+        writer.Int(0);
+        writer.Key("args");
+        writer.StartObject();
+        writer.Key("frame");
+        writer.Uint(event.frame);
+        writer.EndObject();
+        writer.EndObject();
+    }
+
+    writer.EndArray();
+    writer.EndObject();
+
+    std::ofstream file(path);
+    file << buffer.GetString();
+    if (!file)
+    {
+        PrintLog("Failed to write profiler trace to", path);
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cmath>
+
+#include "RenderQueue.h"
+#include "MathLib.h"
+
+using namespace junebug;
+
+// How many batches back a command looks for one with its texture
+static const size_t kBatchLookback = 32;
+
+// The area a command can cover, grown to fit any rotation
+static SDL_Rect CommandBounds(const RenderCommand &command)
+{
+    const SDL_Rect &dest = command.dest;
+    if (command.rotation == 0.0f)
+        return dest;
+
+    float cx = dest.x + dest.w * 0.5f, cy = dest.y + dest.h * 0.5f;
+    float radius = sqrtf((float)(dest.w * dest.w + dest.h * dest.h)) * 0.5f;
+    SDL_Rect bounds;
+    bounds.x = (int)floorf(cx - radius);
+    bounds.y = (int)floorf(cy - radius);
+    bounds.w = (int)ceilf(cx + radius) - bounds.x;
+    bounds.h = (int)ceilf(cy + radius) - bounds.y;
+    return bounds;
+}
+
+void RenderQueue::Submit(const RenderCommand &command)
+{
+    mCommands.push_back(command);
+    mCommands.back().order = (unsigned int)mCommands.size();
+}
+
+void RenderQueue::Flush(SDL_Renderer *renderer)
+{
+    if (mCommands.empty())
+        return;
+
+    // Each command joins the latest batch with its texture, as long as it can be drawn before everything batched since
+    // Otherwise it starts a new batch, so overlapping commands keep the order they were submitted in
+    mBatches.clear();
+    for (RenderCommand &command : mCommands)
+    {
+        SDL_Rect bounds = CommandBounds(command);
+        size_t target = mBatches.size();
+        for (size_t i = mBatches.size(); i > 0 && mBatches.size() - i < kBatchLookback; i--)
+        {
+            Batch &batch = mBatches[i - 1];
+            if (batch.texture == command.texture)
+            {
+                target = i - 1;
+                break;
+            }
+            if (SDL_HasIntersection(&batch.bounds, &bounds))
+                break;
+        }
+
+        if (target == mBatches.size())
+            mBatches.push_back({command.texture, bounds});
+        else
+            SDL_UnionRect(&mBatches[target].bounds, &bounds, &mBatches[target].bounds);
+        command.batch = (unsigned int)target;
+    }
+    std::sort(mCommands.begin(), mCommands.end(), [](const RenderCommand &a, const RenderCommand &b)
+              {
+                  if (a.batch != b.batch)
+                      return a.batch < b.batch;
+                  return a.order < b.order; });
+
+    size_t start = 0;
+    while (start < mCommands.size())
+    {
+        SDL_Texture *texture = mCommands[start].texture;
+        size_t end = start + 1;
+        while (end < mCommands.size() && mCommands[end].batch == mCommands[start].batch)
+            end++;
+
+        bool drawn = false;
+        if (!mGeometryUnsupported)
+        {
+            int w = 1, h = 1;
+            SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
+            float invW = 1.0f / Max(w, 1), invH = 1.0f / Max(h, 1);
+
+            mVertices.clear();
+            mIndices.clear();
+            for (size_t i = start; i < end; i++)
+                AddQuad(mCommands[i], invW, invH);
+
+            if (SDL_RenderGeometry(renderer, texture, mVertices.data(), (int)mVertices.size(), mIndices.data(), (int)mIndices.size()) == 0)
+            {
+                drawn = true;
+                mDrawCalls++;
+            }
+            else
+                mGeometryUnsupported = true;
+        }
+
+        if (!drawn)
+        {
+            for (size_t i = start; i < end; i++)
+                DrawImmediate(renderer, mCommands[i]);
+        }
+
+        start = end;
+    }
+
+    mCommands.clear();
+}
+
+void RenderQueue::AddQuad(const RenderCommand &command, float invTexW, float invTexH)
+{
+    const SDL_Rect &src = command.src, &dest = command.dest;
+
+    float u0 = src.x * invTexW, u1 = (src.x + src.w) * invTexW;
+    float v0 = src.y * invTexH, v1 = (src.y + src.h) * invTexH;
+    if (command.flip & SDL_FLIP_HORIZONTAL)
+        std::swap(u0, u1);
+    if (command.flip & SDL_FLIP_VERTICAL)
+        std::swap(v0, v1);
+
+    // Rotate the corners around the center, matching SDL_RenderCopyEx with a null center
+    float hw = dest.w * 0.5f, hh = dest.h * 0.5f;
+    float cx = dest.x + hw, cy = dest.y + hh;
+    float c = 1.0f, s = 0.0f;
+    if (command.rotation != 0.0f)
+    {
+        float ang = ToRadians(command.rotation);
+        c = Cos(ang);
+        s = Sin(ang);
+    }
+
+    const float corners[4][4] = {
+        {-hw, -hh, u0, v0},
+        {hw, -hh, u1, v0},
+        {hw, hh, u1, v1},
+        {-hw, hh, u0, v1}};
+
+    int base = (int)mVertices.size();
+    for (auto &corner : corners)
+    {
+        SDL_Vertex v;
+        v.position.x = cx + corner[0] * c - corner[1] * s;
+        v.position.y = cy + corner[0] * s + corner[1] * c;
+        v.color = command.color;
+        v.tex_coord.x = corner[2];
+        v.tex_coord.y = corner[3];
+        mVertices.push_back(v);
+    }
+
+    mIndices.push_back(base);
+    mIndices.push_back(base + 1);
+    mIndices.push_back(base + 2);
+    mIndices.push_back(base);
+    mIndices.push_back(base + 2);
+    mIndices.push_back(base + 3);
+}
+
+void RenderQueue::DrawImmediate(SDL_Renderer *renderer, const RenderCommand &command)
+{
+    SDL_SetTextureColorMod(command.texture, command.color.r, command.color.g, command.color.b);
+    SDL_SetTextureAlphaMod(command.texture, command.color.a);
+    SDL_RenderCopyEx(renderer, command.texture, &command.src, &command.dest, command.rotation, nullptr, command.flip);
+    mDrawCalls++;
+}
\ No newline at end of file
@@ -11,13 +11,60 @@ namespace fs = std::filesystem;
 
 namespace junebug
 {
-    void Game::AddSprite(std::string name, std::shared_ptr<class Sprite> sprite)
+    SpriteHandle Game::AddSprite(std::string name, std::shared_ptr<class Sprite> sprite)
     {
-        if (mSpriteCache.find(name) != mSpriteCache.end())
+        auto it = mSpriteCache.find(name);
+        if (it != mSpriteCache.end())
         {
-            mSpriteCache[name].reset();
+            mSpriteSlots[it->second.index].sprite = sprite;
+            return it->second;
+        }
+
+        SpriteHandle handle;
+        if (!mFreeSpriteSlots.empty())
+        {
+            handle.index = mFreeSpriteSlots.back();
+            mFreeSpriteSlots.pop_back();
         }
-        mSpriteCache[name] = sprite;
+        else
+        {
+            handle.index = (unsigned int)mSpriteSlots.size();
+            mSpriteSlots.emplace_back();
+        }
+
+        SpriteSlot &slot = mSpriteSlots[handle.index];
+        slot.sprite = sprite;
+        handle.generation = slot.generation;
+
+        mSpriteCache[name] = handle;
+        return handle;
+    }
+    void Game::RemoveSprite(const std::string &name)
+    {
+        auto it = mSpriteCache.find(name);
+        if (it == mSpriteCache.end())
+            return;
+
+        SpriteSlot &slot = mSpriteSlots[it->second.index];
+        slot.sprite.reset();
+        // Skip zero when wrapping so a reused slot never matches a default handle
+        if (++slot.generation == 0)
+            slot.generation = 1;
+        mFreeSpriteSlots.push_back(it->second.index);
+        mSpriteCache.erase(it);
+    }
+    SpriteHandle Game::FindSprite(const std::string &name) const
+    {
+        auto it = mSpriteCache.find(name);
+        if (it != mSpriteCache.end())
+            return it->second;
+        return SpriteHandle();
+    }
+    std::shared_ptr<Sprite> Game::GetSharedSprite(SpriteHandle handle) const
+    {
+        if (!IsSpriteHandleValid(handle))
+            return nullptr;
+        return mSpriteSlots[handle.index].sprite;
     }
     Vec2<float> GetDrawPosition(Vec2<float> pos)
     {
@@ -32,42 +79,40 @@ namespace junebug
     {
         if (imagePath.empty())
             return nullptr;
-        auto it = Game::Get()->GetSpriteCache().find(imagePath);
-        if (it != Game::Get()->GetSpriteCache().end())
-            return it->second;
+        return Game::Get()->GetSharedSprite(LoadSpriteHandle(imagePath));
+    }
+
+    SpriteHandle LoadSpriteHandle(std::string &imagePath)
+    {
+        Game *game = Game::Get();
+        if (!game || imagePath.empty())
+            return SpriteHandle();
+        SpriteHandle handle = game->FindSprite(imagePath);
+        if (handle.IsValid())
+            return handle;
 
         std::shared_ptr<Sprite> sprite(new Sprite());
 
+        // Failed loads are cached as null sprites so they aren't retried every frame
         std::error_code ec;
         if (fs::is_directory(imagePath, ec))
         {
             if (!sprite->LoadMetadataFile(imagePath))
-            {
-                sprite.reset();
-                Game::Get()->AddSprite(imagePath, nullptr);
-                return nullptr;
-            }
+                return game->AddSprite(imagePath, nullptr);
         }
         else
         {
             if (ec)
             {
                 PrintLog("Error for", imagePath, "in is_directory:", ec.message());
-                sprite.reset();
-                Game::Get()->AddSprite(imagePath, nullptr);
-                return nullptr;
+                return game->AddSprite(imagePath, nullptr);
             }
 
             if (!sprite->LoadTextureFile(imagePath))
-            {
-                sprite.reset();
-                Game::Get()->AddSprite(imagePath, nullptr);
-                return nullptr;
-            }
+                return game->AddSprite(imagePath, nullptr);
         }
 
-        Game::Get()->AddSprite(imagePath, sprite);
-        return sprite;
+        return game->AddSprite(imagePath, sprite);
     }
 
     void DrawSprite(std::string &imagePath, int frame, const Vec2<float> &pos, const SpriteProperties &properties)
@@ -84,6 +129,20 @@ namespace junebug
 
         sprite->Draw(game->GetActiveCamera(), renderer, pos, Vec2<int>::Zero, sprite->GetTexSize(), frame, properties);
     }
+    void DrawSprite(SpriteHandle handle, int frame, const Vec2<float> &pos, const SpriteProperties &properties)
+    {
+        Game *game = Game::Get();
+        if (!game)
+            return;
+        SDL_Renderer *renderer = game->GetRenderer();
+        if (!renderer)
+            return;
+        Sprite *sprite = game->GetSprite(handle);
+        if (!sprite)
+            return;
+
+        sprite->Draw(game->GetActiveCamera(), renderer, pos, Vec2<int>::Zero, sprite->GetTexSize(), frame, properties);
+    }
 
     void DrawSpritePart(std::string &imagePath, int frame, const Vec2<float> &pos, const Vec2<int> &partPos, const Vec2<int> &partSize, const SpriteProperties &properties)
     {
@@ -99,6 +158,20 @@ namespace junebug
 
         sprite->Draw(game->GetActiveCamera(), renderer, pos, partPos, partSize, frame, properties);
     }
+    void DrawSpritePart(SpriteHandle handle, int frame, const Vec2<float> &pos, const Vec2<int> &partPos, const Vec2<int> &partSize, const SpriteProperties &properties)
+    {
+        Game *game = Game::Get();
+        if (!game)
+            return;
+        SDL_Renderer *renderer = game->GetRenderer();
+        if (!renderer)
+            return;
+        Sprite *sprite = game->GetSprite(handle);
+        if (!sprite)
+            return;
+
+        sprite->Draw(game->GetActiveCamera(), renderer, pos, partPos, partSize, frame, properties);
+    }
 
     void DrawText(std::string text, const Vec2<float> &pos, const TextEffects effects)
     {
@@ -115,6 +188,9 @@ namespace junebug
         if (!renderer)
             return;
 
+        // Keep queued sprites underneath whatever is drawn next
+        game->FlushRenderQueue();
+
         Vec2<float> dPos = GetDrawPosition(pos);
         TextEffects cEffects(effects);
         float zoom = game->GetActiveCamera()->GetZoom();
@@ -132,6 +208,8 @@ namespace junebug
         if (!renderer)
             return;
 
+        game->FlushRenderQueue();
+
         Camera *camera = game->GetActiveCamera();
         const Vec2<float> &camPos = (camera) ? camera->GetPosition() : Vec2<>::Zero;
 
@@ -149,6 +227,8 @@ namespace junebug
         if (!renderer)
             return;
 
+        game->FlushRenderQueue();
+
         Camera *camera = game->GetActiveCamera();
         const Vec2<float> &camPos = (camera) ? camera->GetPosition() : Vec2<>::Zero;
 
@@ -182,6 +262,8 @@ namespace junebug
         if (!renderer)
             return;
 
+        game->FlushRenderQueue();
+
         Vec2<float> dPos = GetDrawPosition(pos);
         SDL_Rect rect = {static_cast<int>(dPos.x), static_cast<int>(dPos.y), size.x, size.y};
         SDL_RenderCopy(renderer, texture, nullptr, &rect);
@@ -198,6 +280,8 @@ namespace junebug
         if (!renderer)
             return nullptr;
 
+        game->FlushRenderQueue();
+
         int w, h;
         SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
         SDL_Texture *newTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h), *oldTarget = SDL_GetRenderTarget(renderer);
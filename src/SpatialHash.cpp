@@ -0,0 +1,178 @@
+#include <algorithm>
+
+#include "SpatialHash.h"
+#include "components/Collider.h"
+
+using namespace junebug;
+
+SpatialHash::SpatialHash(float cellSize)
+{
+    mCellSize = Max(cellSize, 1.0f);
+    mInvCellSize = 1.0f / mCellSize;
+}
+
+void SpatialHash::Insert(Collider *coll)
+{
+    coll->mGridOrder = mNextOrder++;
+    coll->mGridStamp = mQueryStamp;
+    coll->mGridIndex = mColliders.size();
+    mColliders.push_back(coll);
+    AddToCells(coll);
+}
+
+void SpatialHash::Remove(Collider *coll)
+{
+    size_t index = coll->mGridIndex;
+    if (index >= mColliders.size() || mColliders[index] != coll)
+        return;
+    mColliders[index] = mColliders.back();
+    mColliders[index]->mGridIndex = index;
+    mColliders.pop_back();
+    RemoveFromCells(coll);
+}
+
+void SpatialHash::Update(Collider *coll)
+{
+    Vec2<int> min, max;
+    bool bounded = GetCellRange(coll, min, max);
+    if (bounded == coll->mGridBounded && (!bounded || (min == coll->mGridMin && max == coll->mGridMax)))
+        return;
+
+    RemoveFromCells(coll);
+    AddToCells(coll);
+}
+
+void SpatialHash::Query(const Vec2<float> &topLeft, const Vec2<float> &bottomRight, std::vector<Collider *> &out)
+{
+    out.clear();
+    if (++mQueryStamp == 0)
+    {
+        // Wrapped around, so reset every stamp to avoid false positives
+        for (Collider *coll : mColliders)
+            coll->mGridStamp = 0;
+        mQueryStamp = 1;
+    }
+
+    for (Collider *coll : mUnbounded)
+    {
+        coll->mGridStamp = mQueryStamp;
+        out.push_back(coll);
+    }
+
+    int minX = (int)floor(topLeft.x * mInvCellSize), minY = (int)floor(topLeft.y * mInvCellSize);
+    int maxX = (int)floor(bottomRight.x * mInvCellSize), maxY = (int)floor(bottomRight.y * mInvCellSize);
+    if ((long long)(maxX - minX + 1) * (maxY - minY + 1) > (long long)mCells.size())
+    {
+        // The box covers more cells than exist, so walk the occupied cells instead
+        for (auto &cell : mCells)
+        {
+            for (Collider *coll : cell.second)
+            {
+                if (coll->mGridStamp == mQueryStamp || coll->mGridMax.x < minX || coll->mGridMin.x > maxX || coll->mGridMax.y < minY || coll->mGridMin.y > maxY)
+                    continue;
+                coll->mGridStamp = mQueryStamp;
+                out.push_back(coll);
+            }
+        }
+    }
+    else
+    {
+        for (int y = minY; y <= maxY; y++)
+        {
+            for (int x = minX; x <= maxX; x++)
+            {
+                auto cell = mCells.find(CellKey(x, y));
+                if (cell == mCells.end())
+                    continue;
+                for (Collider *coll : cell->second)
+                {
+                    if (coll->mGridStamp == mQueryStamp)
+                        continue;
+                    coll->mGridStamp = mQueryStamp;
+                    out.push_back(coll);
+                }
+            }
+        }
+    }
+
+    std::sort(out.begin(), out.end(), [](Collider *a, Collider *b)
+              { return a->mGridOrder < b->mGridOrder; });
+}
+
+void SpatialHash::SetCellSize(float cellSize)
+{
+    cellSize = Max(cellSize, 1.0f);
+    if (cellSize == mCellSize)
+        return;
+
+    mCellSize = cellSize;
+    mInvCellSize = 1.0f / mCellSize;
+    mCells.clear();
+    mUnbounded.clear();
+    for (Collider *coll : mColliders)
+        AddToCells(coll);
+}
+
+bool SpatialHash::GetCellRange(Collider *coll, Vec2<int> &min, Vec2<int> &max) const
+{
+    Vec2<float> topLeft, bottomRight;
+    if (!coll->GetBounds(topLeft, bottomRight))
+        return false;
+    if (!(Abs(topLeft.x) < 1e9f && Abs(topLeft.y) < 1e9f && Abs(bottomRight.x) < 1e9f && Abs(bottomRight.y) < 1e9f))
+        return false;
+
+    min = Vec2<int>((int)floor(topLeft.x * mInvCellSize), (int)floor(topLeft.y * mInvCellSize));
+    max = Vec2<int>((int)floor(bottomRight.x * mInvCellSize), (int)floor(bottomRight.y * mInvCellSize));
+    return (long long)(max.x - min.x + 1) * (max.y - min.y + 1) <= kMaxCells;
+}
+
+void SpatialHash::AddToCells(Collider *coll)
+{
+    coll->mGridBounded = GetCellRange(coll, coll->mGridMin, coll->mGridMax);
+    if (!coll->mGridBounded)
+    {
+        coll->mGridUnboundedIndex = mUnbounded.size();
+        mUnbounded.push_back(coll);
+        return;
+    }
+
+    for (int y = coll->mGridMin.y; y <= coll->mGridMax.y; y++)
+    {
+        for (int x = coll->mGridMin.x; x <= coll->mGridMax.x; x++)
+            mCells[CellKey(x, y)].push_back(coll);
+    }
+}
+
+void SpatialHash::RemoveFromCells(Collider *coll)
+{
+    if (!coll->mGridBounded)
+    {
+        size_t index = coll->mGridUnboundedIndex;
+        if (index < mUnbounded.size() && mUnbounded[index] == coll)
+        {
+            mUnbounded[index] = mUnbounded.back();
+            mUnbounded[index]->mGridUnboundedIndex = index;
+            mUnbounded.pop_back();
+        }
+        return;
+    }
+
+    for (int y = coll->mGridMin.y; y <= coll->mGridMax.y; y++)
+    {
+        for (int x = coll->mGridMin.x; x <= coll->mGridMax.x; x++)
+        {
+            auto cell = mCells.find(CellKey(x, y));
+            if (cell == mCells.end())
+                continue;
+
+            // Order within a cell doesn't matter, so swap and pop
+            auto &list = cell->second;
+            auto it = std::find(list.begin(), list.end(), coll);
+            if (it != list.end())
+            {
+                *it = list.back();
+                list.pop_back();
+            }
+        }
+    }
+}
\ No newline at end of file
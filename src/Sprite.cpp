@@ -45,16 +45,17 @@ void Sprite::SetOrigin(SpriteOrigin origin, const Vec2<int> &offset)
 
 void Sprite::Draw(Camera *cam, SDL_Renderer *renderer, const Vec2<float> &pos, const Vec2<int> &partPos, const Vec2<int> &partSize, int frame, const SpriteProperties &properties)
 {
-    if (frame < 0 || frame >= mTextures.size())
+    if (frame < 0 || frame >= mFrames.size())
         return;
-    SDL_Texture *texture = mTextures[frame];
+    const TextureRegion &region = mFrames[frame];
+    SDL_Texture *texture = region.texture;
     if (texture && cam)
     {
         SDL_Rect src;
         src.w = static_cast<int>(partSize.x);
         src.h = static_cast<int>(partSize.y);
-        src.x = static_cast<int>(partPos.x);
-        src.y = static_cast<int>(partPos.y);
+        src.x = region.rect.x + static_cast<int>(partPos.x);
+        src.y = region.rect.y + static_cast<int>(partPos.y);
 
         SDL_Rect dest;
         dest.w = static_cast<int>(partSize.x * Abs(properties.scale.x) * cam->GetZoom());
@@ -69,67 +70,101 @@ void Sprite::Draw(Camera *cam, SDL_Renderer *renderer, const Vec2<float> &pos, c
         dest.x = static_cast<int>(dPos.x);
         dest.y = static_cast<int>(dPos.y);
 
-        SDL_SetTextureColorMod(texture, properties.color.r, properties.color.g, properties.color.b);
-        SDL_SetTextureAlphaMod(texture, properties.color.a);
+        RenderCommand command;
+        command.texture = texture;
+        command.src = src;
+        command.dest = dest;
+        command.color = properties.color;
         if (properties.scale.x < 0 && properties.scale.y < 0)
-            SDL_RenderCopyEx(renderer,
-                             texture,
-                             &src,
-                             &dest,
-                             -properties.rotation + 180.0f,
-                             nullptr,
-                             SDL_FLIP_NONE);
+        {
+            command.rotation = -properties.rotation + 180.0f;
+            command.flip = SDL_FLIP_NONE;
+        }
+        else
+        {
+            command.rotation = -properties.rotation;
+            command.flip = (properties.scale.x < 0) ? SDL_FLIP_HORIZONTAL : (properties.scale.y < 0) ? SDL_FLIP_VERTICAL
+                                                                                                   : SDL_FLIP_NONE;
+        }
+
+        Game *game = Game::Get();
+        if (game->GetOptions().batchSprites)
+            game->GetRenderQueue().Submit(command);
         else
-            SDL_RenderCopyEx(renderer,
-                             texture,
-                             &src,
-                             &dest,
-                             -properties.rotation,
-                             nullptr,
-                             (properties.scale.x < 0) ? SDL_FLIP_HORIZONTAL : (properties.scale.y < 0) ? SDL_FLIP_VERTICAL
-                                                                                                       : SDL_FLIP_NONE);
+        {
+            SDL_SetTextureColorMod(texture, properties.color.r, properties.color.g, properties.color.b);
+            SDL_SetTextureAlphaMod(texture, properties.color.a);
+            SDL_RenderCopyEx(renderer, texture, &command.src, &command.dest, command.rotation, nullptr, command.flip);
+        }
     }
 }
 
 void Sprite::AddTexture(SDL_Texture *texture)
 {
-    if (!texture || __IsTempSprite__())
+    if (!texture)
         return;
-    mTextures.push_back(texture);
-    if (mTextures.size() == 1)
-        SDL_QueryTexture(texture, nullptr, nullptr, &mTexSize.x, &mTexSize.y);
+    TextureRegion frame;
+    frame.texture = texture;
+    SDL_QueryTexture(texture, nullptr, nullptr, &frame.rect.w, &frame.rect.h);
+    AddFrame(frame);
 }
 
-SDL_Texture *Sprite::LoadTextureFile(std::string &fileName)
+void Sprite::AddFrame(const TextureRegion &frame)
+{
+    // Frames in headless games have a size but no texture
+    if ((!frame.texture && frame.rect.w <= 0) || __IsTempSprite__())
+        return;
+    mFrames.push_back(frame);
+    if (mFrames.size() == 1)
+        mTexSize = Vec2<int>(frame.rect.w, frame.rect.h);
+}
+
+bool Sprite::LoadTextureFile(std::string &fileName)
 {
     if (__IsTempSprite__())
-        return nullptr;
+        return false;
+
+    // Frames that were decoded in the background are already uploaded, so skip the disk check
+    TextureRegion frame;
+    if (Game::Get()->FindTextureRegion(fileName, frame))
+    {
+        AddFrame(frame);
+        return true;
+    }
 
     std::error_code ec;
     if (fs::is_regular_file(fileName, ec))
     {
-        SDL_Texture *tex = Game::Get()->GetTexture(fileName);
-        if (!tex)
-            return nullptr;
+        frame = Game::Get()->GetTextureRegion(fileName);
+        if (frame.rect.w <= 0 || frame.rect.h <= 0)
+            return false;
 
-        AddTexture(tex);
+        AddFrame(frame);
         if (ec)
         {
             PrintLog("Error for", fileName, "in is_regular_file:", ec.message());
-            return nullptr;
+            return false;
         }
-        return tex;
+        return true;
     }
-    return nullptr;
+    return false;
 }
 
 bool Sprite::LoadMetadataFile(std::string &folder)
+{
+    if (__IsTempSprite__())
+        return false;
+
+    Json json(folder + "/" + StringSplitEntry(folder, "/", -1) + ".json");
+    return LoadMetadata(folder, json);
+}
+
+bool Sprite::LoadMetadata(const std::string &folder, Json &json)
 {
     if (__IsTempSprite__())
         return false;
 
     mName = StringSplitEntry(folder, "/", -1);
-    Json json(folder + "/" + mName + ".json");
     if (!json.IsValid())
     {
         print("Sprite metadata", folder, "is invalid");
@@ -139,7 +174,7 @@ bool Sprite::LoadMetadataFile(std::string &folder)
     mFps = Json::GetNumber(&json, "fps", mFps);
 
     // Don't unload textures from the sprite level; just clear the sprite's list
-    mTextures.clear();
+    mFrames.clear();
     std::vector<std::string> frames = Json::GetStringArray(&json, "frames");
     for (auto &frame : frames)
     {
@@ -224,6 +259,18 @@ bool Sprite::LoadMetadataFile(std::string &folder)
     return true;
 }
 
+const std::vector<int> *Sprite::FindAnimation(const std::string &name) const
+{
+    auto it = mAnims.find(name);
+    if (it != mAnims.end())
+        return &it->second;
+
+    auto defIt = mAnims.find("_");
+    if (defIt != mAnims.end())
+        return &defIt->second;
+    return nullptr;
+}
+
 const std::vector<int> &Sprite::GetAnimation(const std::string &name)
 {
     auto it = mAnims.find(name);
@@ -0,0 +1,358 @@
+#include "TextureAtlas.h"
+#include "Files.h"
+#include "Utils.h"
+
+#include "SDL2/SDL_image.h"
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <climits>
+namespace fs = std::filesystem;
+
+using namespace junebug;
+
+static long long GetModifiedTime(const std::string &path)
+{
+    std::error_code ec;
+    auto time = fs::last_write_time(path, ec);
+    if (ec)
+        return 0;
+    return (long long)time.time_since_epoch().count();
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    Clear();
+}
+
+void TextureAtlas::Init(SDL_Renderer *renderer, int pageSize, bool keepSurfaces)
+{
+    Clear();
+    mRenderer = renderer;
+    mKeepSurfaces = keepSurfaces;
+    mPageSize = std::max(pageSize, 64);
+
+    SDL_RendererInfo info;
+    if (renderer && SDL_GetRendererInfo(renderer, &info) == 0)
+    {
+        if (info.max_texture_width > 0)
+            mPageSize = std::min(mPageSize, info.max_texture_width);
+        if (info.max_texture_height > 0)
+            mPageSize = std::min(mPageSize, info.max_texture_height);
+    }
+}
+
+bool TextureAtlas::Insert(const std::string &name, SDL_Surface *surface, TextureRegion &region)
+{
+    if (!surface || !mRenderer || surface->w + mPadding > mPageSize || surface->h + mPadding > mPageSize)
+        return false;
+
+    SDL_Rect rect;
+    size_t pageIndex = 0;
+    for (; pageIndex < mPages.size(); pageIndex++)
+    {
+        if (Pack(mPages[pageIndex], surface->w, surface->h, rect))
+            break;
+    }
+    if (pageIndex == mPages.size())
+    {
+        if (!AddPage() || !Pack(mPages.back(), surface->w, surface->h, rect))
+            return false;
+    }
+    Page &page = mPages[pageIndex];
+
+    SDL_Surface *converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (!converted)
+    {
+        PrintLog("Failed to convert", name, "for the texture atlas:", SDL_GetError());
+        return false;
+    }
+    SDL_UpdateTexture(page.texture, &rect, converted->pixels, converted->pitch);
+    if (page.surface)
+    {
+        // Copy the raw pixels rather than blending onto the empty page
+        SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+        SDL_Rect dest = rect;
+        SDL_BlitSurface(converted, nullptr, page.surface, &dest);
+    }
+    SDL_FreeSurface(converted);
+
+    mEntries[name] = {(int)pageIndex, rect, GetModifiedTime(name)};
+    mDirty = true;
+
+    region.texture = page.texture;
+    region.rect = rect;
+    return true;
+}
+
+bool TextureAtlas::Find(const std::string &name, TextureRegion &region) const
+{
+    auto it = mEntries.find(name);
+    if (it == mEntries.end())
+        return false;
+
+    region.texture = mPages[it->second.page].texture;
+    region.rect = it->second.rect;
+    return true;
+}
+
+bool TextureAtlas::SaveCache(const std::string &folder)
+{
+    if (!mKeepSurfaces)
+    {
+        PrintLog("Texture atlas pages weren't kept on the CPU, so the cache can't be saved");
+        return false;
+    }
+
+    std::error_code ec;
+    fs::create_directories(folder, ec);
+
+    Document doc;
+    doc.SetObject();
+    auto &allocator = doc.GetAllocator();
+    doc.AddMember("pageSize", mPageSize, allocator);
+
+    Value pages(kArrayType);
+    for (size_t i = 0; i < mPages.size(); i++)
+    {
+        std::string file = "page" + std::to_string(i) + ".png";
+        if (IMG_SavePNG(mPages[i].surface, (folder + "/" + file).c_str()) != 0)
+        {
+            PrintLog("Failed to save texture atlas page", file, ":", IMG_GetError());
+            return false;
+        }
+
+        Value page(kObjectType), skyline(kArrayType);
+        page.AddMember("file", Value(file.c_str(), allocator), allocator);
+        for (auto &node : mPages[i].skyline)
+        {
+            Value n(kArrayType);
+            n.PushBack(node.x, allocator).PushBack(node.y, allocator).PushBack(node.width, allocator);
+            skyline.PushBack(n, allocator);
+        }
+        page.AddMember("skyline", skyline, allocator);
+        pages.PushBack(page, allocator);
+    }
+    doc.AddMember("pages", pages, allocator);
+
+    Value entries(kObjectType);
+    for (auto &entry : mEntries)
+    {
+        Value e(kArrayType);
+        e.PushBack(entry.second.page, allocator)
+            .PushBack(entry.second.rect.x, allocator)
+            .PushBack(entry.second.rect.y, allocator)
+            .PushBack(entry.second.rect.w, allocator)
+            .PushBack(entry.second.rect.h, allocator)
+            .PushBack((int64_t)entry.second.modified, allocator);
+        entries.AddMember(Value(entry.first.c_str(), allocator), e, allocator);
+    }
+    doc.AddMember("entries", entries, allocator);
+
+    StringBuffer buffer;
+    Writer<StringBuffer> writer(buffer);
+    doc.Accept(writer);
+    std::ofstream file(folder + "/atlas.json");
+    file << buffer.GetString();
+    if (!file)
+        return false;
+
+    mDirty = false;
+    return true;
+}
+
+bool TextureAtlas::LoadCache(const std::string &folder)
+{
+    std::error_code ec;
+    if (!mRenderer || !fs::is_regular_file(folder + "/atlas.json", ec))
+        return false;
+
+    Json json(folder + "/atlas.json");
+    if (!json.IsValid() || Json::GetInt(&json, "pageSize") != mPageSize)
+        return false;
+
+    Clear();
+    Document *doc = json.GetDoc();
+    if (doc->HasMember("pages") && (*doc)["pages"].IsArray())
+    {
+        for (auto &pageRef : (*doc)["pages"].GetArray())
+        {
+            if (!pageRef.IsObject())
+                continue;
+            std::string file = folder + "/" + Json::GetString(pageRef.GetObject(), "file");
+
+            SDL_Surface *surface = IMG_Load(file.c_str());
+            if (!surface || surface->w != mPageSize || surface->h != mPageSize || !AddPage(surface))
+            {
+                PrintLog("Texture atlas cache page", file, "is invalid");
+                if (surface)
+                    SDL_FreeSurface(surface);
+                Clear();
+                return false;
+            }
+            SDL_FreeSurface(surface);
+
+            Page &page = mPages.back();
+            page.skyline.clear();
+            if (pageRef.HasMember("skyline") && pageRef["skyline"].IsArray())
+            {
+                for (auto &node : pageRef["skyline"].GetArray())
+                {
+                    std::vector<int> n = Json::GetNumberArray<int>(node);
+                    if (n.size() == 3)
+                        page.skyline.push_back({n[0], n[1], n[2]});
+                }
+            }
+            if (page.skyline.empty())
+                page.skyline.push_back({0, mPageSize, mPageSize});
+        }
+    }
+
+    if (doc->HasMember("entries") && (*doc)["entries"].IsObject())
+    {
+        for (auto &entryRef : (*doc)["entries"].GetObject())
+        {
+            if (!entryRef.value.IsArray() || entryRef.value.Size() != 6)
+                continue;
+            auto e = entryRef.value.GetArray();
+            std::string name = entryRef.name.GetString();
+
+            // Skip images that have changed on disk; they'll be packed again when loaded
+            long long modified = e[5].IsInt64() ? e[5].GetInt64() : 0;
+            if (modified != GetModifiedTime(name))
+                continue;
+
+            int page = Json::GetInt(e[0], -1);
+            if (page < 0 || page >= (int)mPages.size())
+                continue;
+            mEntries[name] = {page, {Json::GetInt(e[1]), Json::GetInt(e[2]), Json::GetInt(e[3]), Json::GetInt(e[4])}, modified};
+        }
+    }
+
+    mDirty = false;
+    return true;
+}
+
+void TextureAtlas::Clear()
+{
+    for (Page &page : mPages)
+    {
+        if (page.texture)
+            SDL_DestroyTexture(page.texture);
+        if (page.surface)
+            SDL_FreeSurface(page.surface);
+    }
+    mPages.clear();
+    mEntries.clear();
+}
+
+bool TextureAtlas::AddPage(SDL_Surface *contents)
+{
+    // New surfaces are zeroed, so this also gives the page a transparent background
+    SDL_Surface *surface = contents ? SDL_ConvertSurfaceFormat(contents, SDL_PIXELFORMAT_RGBA32, 0) : SDL_CreateRGBSurfaceWithFormat(0, mPageSize, mPageSize, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface)
+        return false;
+
+    SDL_Texture *texture = SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, mPageSize, mPageSize);
+    if (!texture)
+    {
+        PrintLog("Failed to create texture atlas page:", SDL_GetError());
+        SDL_FreeSurface(surface);
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_UpdateTexture(texture, nullptr, surface->pixels, surface->pitch);
+
+    if (!mKeepSurfaces)
+    {
+        SDL_FreeSurface(surface);
+        surface = nullptr;
+    }
+
+    Page page;
+    page.texture = texture;
+    page.surface = surface;
+    page.skyline.push_back({0, 0, mPageSize});
+    mPages.push_back(page);
+    return true;
+}
+
+bool TextureAtlas::Pack(Page &page, int w, int h, SDL_Rect &rect)
+{
+    int paddedW = w + mPadding, paddedH = h + mPadding;
+    int bestY = INT_MAX, bestWidth = INT_MAX;
+    size_t bestIndex = page.skyline.size();
+
+    // Bottom-left heuristic: lowest top edge wins, ties go to the narrowest node
+    for (size_t i = 0; i < page.skyline.size(); i++)
+    {
+        int y = SkylineFit(page, i, paddedW, paddedH);
+        if (y < 0)
+            continue;
+        if (y + paddedH < bestY || (y + paddedH == bestY && page.skyline[i].width < bestWidth))
+        {
+            bestY = y + paddedH;
+            bestWidth = page.skyline[i].width;
+            bestIndex = i;
+        }
+    }
+    if (bestIndex == page.skyline.size())
+        return false;
+
+    SDL_Rect padded = {page.skyline[bestIndex].x, bestY - paddedH, paddedW, paddedH};
+    SkylineAdd(page, bestIndex, padded);
+    rect = {padded.x, padded.y, w, h};
+    return true;
+}
+
+int TextureAtlas::SkylineFit(const Page &page, size_t index, int w, int h) const
+{
+    int x = page.skyline[index].x;
+    if (x + w > mPageSize)
+        return -1;
+
+    int y = page.skyline[index].y, widthLeft = w;
+    for (size_t i = index; widthLeft > 0; i++)
+    {
+        if (i >= page.skyline.size())
+            return -1;
+        y = std::max(y, page.skyline[i].y);
+        if (y + h > mPageSize)
+            return -1;
+        widthLeft -= page.skyline[i].width;
+    }
+    return y;
+}
+
+void TextureAtlas::SkylineAdd(Page &page, size_t index, const SDL_Rect &rect)
+{
+    auto &skyline = page.skyline;
+    skyline.insert(skyline.begin() + index, {rect.x, rect.y + rect.h, rect.w});
+
+    // Trim or remove the nodes now covered by the new one
+    for (size_t i = index + 1; i < skyline.size();)
+    {
+        const SkylineNode &prev = skyline[i - 1];
+        if (skyline[i].x >= prev.x + prev.width)
+            break;
+
+        int shrink = prev.x + prev.width - skyline[i].x;
+        skyline[i].x += shrink;
+        skyline[i].width -= shrink;
+        if (skyline[i].width > 0)
+            break;
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size();)
+    {
+        if (skyline[i].y == skyline[i + 1].y)
+        {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        }
+        else
+            i++;
+    }
+}
\ No newline at end of file
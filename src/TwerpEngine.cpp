@@ -0,0 +1,381 @@
+#include "TwerpEngine.h"
+#include "Actors.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace junebug;
+
+namespace
+{
+    // IDs hold a record index in their low bits and the record's generation in their high bits
+    const uint32_t kIndexBits = 20;
+    const uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    const uint32_t kGenerationMask = (1u << (32 - kIndexBits)) - 1;
+
+    // Interpolate between two values by an eased position
+    inline float TwerpLerp(float start, float end, float pos)
+    {
+        return start + (end - start) * pos;
+    }
+    inline int TwerpLerp(int start, int end, float pos)
+    {
+        return (int)TwerpLerp((float)start, (float)end, pos);
+    }
+    // Curves can overshoot, so 8-bit values are clamped rather than wrapped
+    inline Uint8 TwerpLerp(Uint8 start, Uint8 end, float pos)
+    {
+        return (Uint8)std::min(std::max(TwerpLerp((float)start, (float)end, pos), 0.0f), 255.0f);
+    }
+    inline Vec2<float> TwerpLerp(const Vec2<float> &start, const Vec2<float> &end, float pos)
+    {
+        return Vec2<float>(TwerpLerp(start.x, end.x, pos), TwerpLerp(start.y, end.y, pos));
+    }
+    inline Color TwerpLerp(const Color &start, const Color &end, float pos)
+    {
+        return Color(TwerpLerp(start.r, end.r, pos), TwerpLerp(start.g, end.g, pos),
+                     TwerpLerp(start.b, end.b, pos), TwerpLerp(start.a, end.a, pos));
+    }
+
+    // Write a value to a coroutine's target
+    template <typename T>
+    inline void TwerpWrite(T *target, const T &value)
+    {
+        *target = value;
+    }
+    inline void TwerpWrite(VisualActor *target, const Vec2<float> &value)
+    {
+        target->SetPosition(value);
+    }
+
+    template <typename V>
+    inline void SwapPop(V &vec, size_t index)
+    {
+        vec[index] = vec.back();
+        vec.pop_back();
+    }
+}
+
+// The data every batch has, one entry per coroutine
+struct TwerpEngine::Batch
+{
+    Batch(TwerpType type) : type(type) {}
+    virtual ~Batch() = default;
+
+    // Write every running coroutine's value at its eased position
+    virtual void Write() = 0;
+    // Write a coroutine's end value
+    virtual void WriteEnd(uint32_t index) = 0;
+
+    // Remove the coroutine at an index by moving the last one into its place
+    void SwapRemove(uint32_t index)
+    {
+        SwapPop(elapsed, index);
+        SwapPop(duration, index);
+        SwapPop(opt1, index);
+        SwapPop(opt2, index);
+        SwapPop(pos, index);
+        SwapPop(looped, index);
+        SwapPop(paused, index);
+        SwapPop(ids, index);
+        SwapRemoveTyped(index);
+    }
+    virtual void SwapRemoveTyped(uint32_t index) = 0;
+
+    TwerpType type;
+    std::vector<float> elapsed, duration, opt1, opt2;
+    // Each coroutine's eased position for the current update
+    std::vector<float> pos;
+    std::vector<Uint8> looped, paused;
+    std::vector<TwerpId> ids;
+};
+
+template <typename T, typename Target>
+struct TwerpEngine::TypedBatch : TwerpEngine::Batch
+{
+    TypedBatch(TwerpType type) : Batch(type) {}
+
+    void Write() override
+    {
+        size_t count = ids.size();
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!paused[i])
+                TwerpWrite(targets[i], TwerpLerp(start[i], end[i], pos[i]));
+        }
+    }
+
+    void WriteEnd(uint32_t index) override
+    {
+        TwerpWrite(targets[index], end[index]);
+    }
+
+    void SwapRemoveTyped(uint32_t index) override
+    {
+        SwapPop(start, index);
+        SwapPop(end, index);
+        SwapPop(targets, index);
+    }
+
+    std::vector<T> start, end;
+    std::vector<Target> targets;
+};
+
+TwerpEngine::TwerpEngine()
+{
+    mBatches.resize(KIND_COUNT * TWERP_COUNT);
+}
+
+TwerpEngine::~TwerpEngine() = default;
+
+TwerpId TwerpEngine::Add(Actor *owner, float &value, float start, float end, float time, TwerpType type, bool looped, float opt1, float opt2)
+{
+    return AddTyped(KIND_FLOAT, owner, &value, &value, start, end, time, type, looped, opt1, opt2);
+}
+TwerpId TwerpEngine::Add(Actor *owner, int &value, int start, int end, float time, TwerpType type, bool looped, float opt1, float opt2)
+{
+    return AddTyped(KIND_INT, owner, &value, &value, start, end, time, type, looped, opt1, opt2);
+}
+TwerpId TwerpEngine::Add(Actor *owner, Uint8 &value, Uint8 start, Uint8 end, float time, TwerpType type, bool looped, float opt1, float opt2)
+{
+    return AddTyped(KIND_UINT8, owner, &value, &value, start, end, time, type, looped, opt1, opt2);
+}
+TwerpId TwerpEngine::Add(Actor *owner, Vec2<float> &value, Vec2<float> start, Vec2<float> end, float time, TwerpType type, bool looped, float opt1, float opt2)
+{
+    return AddTyped(KIND_VEC2, owner, &value, &value, start, end, time, type, looped, opt1, opt2);
+}
+TwerpId TwerpEngine::Add(Actor *owner, Color &value, Color start, Color end, float time, TwerpType type, bool looped, float opt1, float opt2)
+{
+    return AddTyped(KIND_COLOR, owner, &value, &value, start, end, time, type, looped, opt1, opt2);
+}
+TwerpId TwerpEngine::AddPosition(VisualActor *actor, Vec2<float> start, Vec2<float> end, float time, TwerpType type, bool looped, float opt1, float opt2)
+{
+    // The actor itself stands in for its position when looking up the coroutine
+    return AddTyped(KIND_POSITION, actor, actor, actor, start, end, time, type, looped, opt1, opt2);
+}
+
+template <typename T, typename Target>
+TwerpId TwerpEngine::AddTyped(int kind, Actor *owner, const void *key, Target target, T start, T end, float time, TwerpType type, bool looped, float opt1, float opt2)
+{
+    if (!owner || type < 0 || type >= TWERP_COUNT)
+        return kNoTwerp;
+
+    // A value only has one coroutine of each kind at a time
+    // A vector and its x share an address, so they're told apart by kind
+    TargetKey targetKey = {key, kind};
+    auto existing = mTargets.find(targetKey);
+    if (existing != mTargets.end())
+    {
+        Record *record = FindRecord(existing->second);
+        if (record)
+            RemoveAt(*mBatches[record->batch], record->index);
+    }
+
+    if (time <= 0.0f)
+    {
+        TwerpWrite(target, end);
+        return kNoTwerp;
+    }
+    if (mFreeRecords.empty() && mRecords.size() > kIndexMask)
+    {
+        PrintLog("Too many twerp coroutines are running");
+        return kNoTwerp;
+    }
+
+    uint32_t batchId = kind * TWERP_COUNT + type;
+    if (!mBatches[batchId])
+        mBatches[batchId].reset(new TypedBatch<T, Target>(type));
+    auto &batch = static_cast<TypedBatch<T, Target> &>(*mBatches[batchId]);
+
+    uint32_t recordIndex;
+    if (!mFreeRecords.empty())
+    {
+        recordIndex = mFreeRecords.back();
+        mFreeRecords.pop_back();
+    }
+    else
+    {
+        recordIndex = (uint32_t)mRecords.size();
+        mRecords.emplace_back();
+    }
+
+    Record &record = mRecords[recordIndex];
+    // Generations start from 1, so no ID is kNoTwerp
+    record.generation = (record.generation + 1) & kGenerationMask;
+    if (record.generation == 0)
+        record.generation = 1;
+    record.batch = batchId;
+    record.index = (uint32_t)batch.ids.size();
+    record.active = true;
+    record.owner = owner;
+    record.target = targetKey;
+    TwerpId id = (record.generation << kIndexBits) | recordIndex;
+
+    TwerpDefaultOptions(type, opt1, opt2);
+    batch.elapsed.push_back(0.0f);
+    batch.duration.push_back(time);
+    batch.opt1.push_back(opt1);
+    batch.opt2.push_back(opt2);
+    batch.pos.push_back(0.0f);
+    batch.looped.push_back(looped);
+    batch.paused.push_back(0);
+    batch.ids.push_back(id);
+    batch.start.push_back(start);
+    batch.end.push_back(end);
+    batch.targets.push_back(target);
+
+    mTargets[targetKey] = id;
+    mOwned[owner].push_back(id);
+    mCount++;
+
+    TwerpWrite(target, start);
+    return id;
+}
+
+TwerpEngine::Record *TwerpEngine::FindRecord(TwerpId id)
+{
+    uint32_t index = id & kIndexMask;
+    if (id == kNoTwerp || index >= mRecords.size())
+        return nullptr;
+    Record &record = mRecords[index];
+    if (!record.active || record.generation != (id >> kIndexBits))
+        return nullptr;
+    return &record;
+}
+
+bool TwerpEngine::Toggle(Record &record, int forceState)
+{
+    Uint8 &paused = mBatches[record.batch]->paused[record.index];
+    if (forceState == -1)
+        paused = !paused;
+    else if (forceState == 0)
+        paused = 1;
+    else if (forceState == 1)
+        paused = 0;
+    return true;
+}
+
+bool TwerpEngine::Toggle(TwerpId id, int forceState)
+{
+    Record *record = FindRecord(id);
+    return record && Toggle(*record, forceState);
+}
+
+bool TwerpEngine::Toggle(Actor *owner, const void *value, int kind, int forceState)
+{
+    auto it = mTargets.find({value, kind});
+    if (it == mTargets.end())
+        return false;
+    Record *record = FindRecord(it->second);
+    return record && record->owner == owner && Toggle(*record, forceState);
+}
+
+bool TwerpEngine::Stop(TwerpId id)
+{
+    Record *record = FindRecord(id);
+    if (!record)
+        return false;
+    RemoveAt(*mBatches[record->batch], record->index);
+    return true;
+}
+
+bool TwerpEngine::Stop(Actor *owner, const void *value, int kind)
+{
+    auto it = mTargets.find({value, kind});
+    if (it == mTargets.end())
+        return false;
+    Record *record = FindRecord(it->second);
+    if (!record || record->owner != owner)
+        return false;
+    RemoveAt(*mBatches[record->batch], record->index);
+    return true;
+}
+
+void TwerpEngine::RemoveOwner(Actor *owner)
+{
+    auto it = mOwned.find(owner);
+    if (it == mOwned.end())
+        return;
+
+    OwnedList ids = std::move(it->second);
+    mOwned.erase(it);
+    for (TwerpId id : ids)
+    {
+        Record *record = FindRecord(id);
+        if (record)
+            RemoveAt(*mBatches[record->batch], record->index);
+    }
+}
+
+void TwerpEngine::RemoveAt(Batch &batch, uint32_t index)
+{
+    TwerpId id = batch.ids[index];
+    uint32_t recordIndex = id & kIndexMask;
+    Record &record = mRecords[recordIndex];
+
+    auto target = mTargets.find(record.target);
+    if (target != mTargets.end() && target->second == id)
+        mTargets.erase(target);
+
+    auto owned = mOwned.find(record.owner);
+    if (owned != mOwned.end())
+    {
+        OwnedList &ids = owned->second;
+        auto it = std::find(ids.begin(), ids.end(), id);
+        if (it != ids.end())
+            SwapPop(ids, it - ids.begin());
+        if (ids.empty())
+            mOwned.erase(owned);
+    }
+
+    uint32_t last = (uint32_t)batch.ids.size() - 1;
+    if (index != last)
+        mRecords[batch.ids[last] & kIndexMask].index = index;
+    batch.SwapRemove(index);
+
+    record.active = false;
+    record.owner = nullptr;
+    record.target = TargetKey();
+    mFreeRecords.push_back(recordIndex);
+    mCount--;
+}
+
+void TwerpEngine::Update(float dt)
+{
+    for (auto &batchPtr : mBatches)
+    {
+        if (!batchPtr || batchPtr->ids.empty())
+            continue;
+        Batch &batch = *batchPtr;
+
+        size_t count = batch.ids.size();
+        float *elapsed = batch.elapsed.data(), *pos = batch.pos.data();
+        const float *duration = batch.duration.data();
+        const Uint8 *looped = batch.looped.data(), *paused = batch.paused.data();
+
+        // Advance time and find each coroutine's position on the curve
+        for (size_t i = 0; i < count; i++)
+        {
+            elapsed[i] += paused[i] ? 0.0f : dt;
+            float t = elapsed[i] / duration[i];
+            pos[i] = looped[i] ? t - std::floor(t) : std::min(t, 1.0f);
+        }
+        TwerpEaseBatch(batch.type, pos, batch.opt1.data(), batch.opt2.data(), count);
+        batch.Write();
+
+        // Wrap or finish coroutines that reached the end
+        // This goes from the back, so every coroutine swapped into a removed one's place was already checked
+        for (size_t i = count; i-- > 0;)
+        {
+            if (elapsed[i] < duration[i])
+                continue;
+            if (looped[i])
+                elapsed[i] = std::fmod(elapsed[i], duration[i]);
+            else
+            {
+                batch.WriteEnd((uint32_t)i);
+                RemoveAt(batch, (uint32_t)i);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -4,289 +4,422 @@
 
 namespace junebug
 {
-    float _TwerpHelper(float _start, float _end, float _pos, TwerpType _type, bool _looped, float _opt1, float _opt2)
+    // Each curve eases a position from 0 to 1
+    // In-out curves run the in curve over the first half and the out curve over the second, so nothing recurses
+    static inline float EaseInOut(float _pos, float _in, float _out)
     {
-        if (_type < 0 || _type >= TwerpType::TWERP_COUNT)
-            return 0.0f;
+        return _pos < 0.5f ? _in * 0.5f : 0.5f + _out * 0.5f;
+    }
 
-        _pos = Clamp<float>(_looped ? fmod(_pos, 1.0f) : _pos, 0.0f, 1.0f);
-        float _chng = _end - _start;
-        float _mid = (_start + _end) / 2;
+    static inline float EaseInBack(float _pos, float _b)
+    {
+        return _pos * _pos * ((_b + 1) * _pos - _b);
+    }
+    static inline float EaseOutBack(float _pos, float _b)
+    {
+        _pos--;
+        return _pos * _pos * ((_b + 1) * _pos + _b) + 1;
+    }
+
+    static inline float EaseOutBounce(float _pos)
+    {
+        const float _k = Twerp_Bounce_DefaultBounciness;
+        if (_pos < 1.0f / 2.75f)
+            return _k * _pos * _pos;
+        if (_pos < 2.0f / 2.75f)
+        {
+            _pos -= 1.5f / 2.75f;
+            return _k * _pos * _pos + 0.75f;
+        }
+        if (_pos < 2.5f / 2.75f)
+        {
+            _pos -= 2.25f / 2.75f;
+            return _k * _pos * _pos + 0.9375f;
+        }
+        _pos -= 2.625f / 2.75f;
+        return _k * _pos * _pos + 0.984375f;
+    }
+    static inline float EaseInBounce(float _pos)
+    {
+        return 1 - EaseOutBounce(1 - _pos);
+    }
 
-        float _b = _opt1 == Twerp_Undefined ? Twerp_Back_DefaultBounciness : _opt1;
+    static inline float EaseInCircle(float _pos)
+    {
+        return 1 - sqrtf(Max(1 - _pos * _pos, 0.0f));
+    }
+    static inline float EaseOutCircle(float _pos)
+    {
+        _pos--;
+        return sqrtf(Max(1 - _pos * _pos, 0.0f));
+    }
+
+    static inline float EaseInCubic(float _pos)
+    {
+        return _pos * _pos * _pos;
+    }
+    static inline float EaseOutCubic(float _pos)
+    {
+        _pos--;
+        return _pos * _pos * _pos + 1;
+    }
+
+    // _e and _d shape the wobble: the period is _d * _e, and _d sets how many wobbles fit in the curve
+    static inline float EaseInElastic(float _pos, float _e, float _d)
+    {
+        if (_pos <= 0)
+            return 0;
+        if (_pos >= 1)
+            return 1;
+        float _p = _d * _e;
+        float _s = _p * 0.25f;
+        _pos--;
+        return -(powf(2.0f, 10 * _pos) * sinf((_pos * _d - _s) * (2 * Pi) / _p));
+    }
+    static inline float EaseOutElastic(float _pos, float _e, float _d)
+    {
+        if (_pos <= 0)
+            return 0;
+        if (_pos >= 1)
+            return 1;
+        float _p = _d * _e;
+        float _s = _p * 0.25f;
+        return powf(2.0f, -10 * _pos) * sinf((_pos * _d - _s) * (2 * Pi) / _p) + 1;
+    }
+
+    static inline float EaseInExpo(float _pos)
+    {
+        return _pos <= 0 ? 0 : powf(2.0f, 10 * (_pos - 1));
+    }
+    static inline float EaseOutExpo(float _pos)
+    {
+        return _pos >= 1 ? 1 : 1 - powf(2.0f, -10 * _pos);
+    }
+
+    static inline float EaseInQuad(float _pos)
+    {
+        return _pos * _pos;
+    }
+    static inline float EaseOutQuad(float _pos)
+    {
+        return -_pos * (_pos - 2);
+    }
+
+    static inline float EaseInQuart(float _pos)
+    {
+        return _pos * _pos * _pos * _pos;
+    }
+    static inline float EaseOutQuart(float _pos)
+    {
+        _pos--;
+        return 1 - _pos * _pos * _pos * _pos;
+    }
+
+    static inline float EaseInQuint(float _pos)
+    {
+        return _pos * _pos * _pos * _pos * _pos;
+    }
+    static inline float EaseOutQuint(float _pos)
+    {
+        _pos--;
+        return _pos * _pos * _pos * _pos * _pos + 1;
+    }
+
+    // Apply an easing function to every position
+    // Each call site passes its own lambda, so the function is inlined into the loop
+    template <typename F>
+    static inline void EaseAll(float *_pos, size_t _count, F _ease)
+    {
+        for (size_t i = 0; i < _count; i++)
+            _pos[i] = _ease(_pos[i]);
+    }
+    template <typename F>
+    static inline void EaseAll(float *_pos, const float *_opt1, const float *_opt2, size_t _count, F _ease)
+    {
+        for (size_t i = 0; i < _count; i++)
+            _pos[i] = _ease(_pos[i], _opt1[i], _opt2[i]);
+    }
+
+    void TwerpEaseBatch(TwerpType _type, float *_pos, const float *_opt1, const float *_opt2, size_t _count)
+    {
         switch (_type)
         {
         case TWERP_LINEAR:
-            return _start + (_end - _start) * _pos;
+            break;
 
         case TWERP_INOUT_BACK:
-            return (_pos < 0.5f)
-                       ? Twerp(_start, _mid, _pos * 2.0f, TWERP_IN_BACK, _looped, _b, _opt2) / 2.0f
-                       : Twerp(_mid, _end, (_pos - 0.5f) * 2.0f - 1.0f, TWERP_OUT_BACK, _looped, _b, _opt2);
+            EaseAll(_pos, _opt1, _opt2, _count, [](float t, float b, float)
+                    { return EaseInOut(t, EaseInBack(t * 2, b), EaseOutBack(t * 2 - 1, b)); });
+            break;
         case TWERP_IN_BACK:
-            return _chng * _pos * _pos * ((_b + 1) * _pos - _b) + _start;
+            EaseAll(_pos, _opt1, _opt2, _count, [](float t, float b, float)
+                    { return EaseInBack(t, b); });
+            break;
         case TWERP_OUT_BACK:
-        {
-            _pos--;
-            return _chng * (_pos * _pos * ((_b + 1) * _pos + _b) + 1) + _start;
-        }
+            EaseAll(_pos, _opt1, _opt2, _count, [](float t, float b, float)
+                    { return EaseOutBack(t, b); });
+            break;
 
         case TWERP_INOUT_BOUNCE:
-            return (_pos < 0.5f)
-                       ? Twerp(_start, _mid, _pos * 2.0f, TWERP_IN_BOUNCE, _looped, _opt1, _opt2)
-                       : Twerp(_mid, _end, (_pos - 0.5f) * 2.0f, TWERP_OUT_BOUNCE, _looped, _opt1, _opt2);
-        case TWERP_IN_BOUNCE:
-        {
-            _chng = _end - _pos;
-            _pos = 1 - _pos;
-            return _chng - Twerp(_start, _end, _pos, TWERP_OUT_BOUNCE, _looped, Twerp_Bounce_DefaultBounciness) + _start;
-        }
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInOut(t, EaseInBounce(t * 2), EaseOutBounce(t * 2 - 1)); });
+            break;
         case TWERP_OUT_BOUNCE:
-        {
-            if (_pos < 1.0f / 2.75f)
-                return _chng * (Twerp_Bounce_DefaultBounciness * _pos * _pos) + _start;
-            else if (_pos < 2.0f / 2.75f)
-            {
-                _pos -= 1.5f / 2.75f;
-                return _chng * (Twerp_Bounce_DefaultBounciness * _pos * _pos + 3 / 4) + _start;
-            }
-            else if (_pos < 2.5 / 2.75)
-            {
-                _pos -= 2.25f / 2.75f;
-                return _chng * (Twerp_Bounce_DefaultBounciness * _pos * _pos + 15 / 16) + _start;
-            }
-
-            _pos -= 2.625f / 2.75f;
-            return _chng * (Twerp_Bounce_DefaultBounciness * _pos * _pos + 63 / 64) + _start;
-        }
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseOutBounce(t); });
+            break;
+        case TWERP_IN_BOUNCE:
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInBounce(t); });
+            break;
 
         case TWERP_INOUT_CIRCLE:
-            return (_pos < .5) ? Twerp(_start, _mid, _pos * 2, TWERP_IN_CIRCLE)
-                               : Twerp(_mid, _end, (_pos - .5f) * 2, TWERP_OUT_CIRCLE);
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInOut(t, EaseInCircle(t * 2), EaseOutCircle(t * 2 - 1)); });
+            break;
         case TWERP_OUT_CIRCLE:
-        {
-            _pos--;
-            return _chng * sqrt(1 - _pos * _pos) + _start;
-        }
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseOutCircle(t); });
+            break;
         case TWERP_IN_CIRCLE:
-            return -_chng * (sqrt(1 - _pos * _pos) - 1) + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInCircle(t); });
+            break;
 
         case TWERP_INOUT_CUBIC:
-            return (_pos < .5) ? Twerp(_start, _mid, _pos * 2, TWERP_IN_CUBIC)
-                               : Twerp(_mid, _end, (_pos - .5f) * 2, TWERP_OUT_CUBIC);
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInOut(t, EaseInCubic(t * 2), EaseOutCubic(t * 2 - 1)); });
+            break;
         case TWERP_OUT_CUBIC:
-        {
-            return _chng * (pow(_pos - 1.0f, 3.0f) + 1.0f) + _start;
-        }
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseOutCubic(t); });
+            break;
         case TWERP_IN_CUBIC:
-        {
-            return _chng * pow(_pos, 3.0f) + _start;
-        }
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInCubic(t); });
+            break;
 
         case TWERP_INOUT_ELASTIC:
-        {
-            float _e = _opt1 != Twerp_Undefined ? _opt1 : 0.3f;
-            float _d = _opt2 != Twerp_Undefined ? _opt2 : 5.0f;
-
-            return (_pos < .5) ? Twerp(_start, _mid, _pos * 2, TWERP_IN_ELASTIC, _e, _d)
-                               : Twerp(_mid, _end, (_pos - .5f) * 2, TWERP_OUT_ELASTIC, _e, _d);
-        }
+            EaseAll(_pos, _opt1, _opt2, _count, [](float t, float e, float d)
+                    { return EaseInOut(t, EaseInElastic(t * 2, e, d), EaseOutElastic(t * 2 - 1, e, d)); });
+            break;
         case TWERP_OUT_ELASTIC:
-        {
-            float _s, _p;
-            float _e = _opt1 != Twerp_Undefined ? _opt1 : 0.3f;
-            float _d = _opt2 != Twerp_Undefined ? _opt2 : 5.0f;
-
-            if (_pos == 0 || _chng == 0)
-                return _start;
-            if (_pos == 1)
-                return _end;
-
-            _p = _d * _e;
-            _s = (Sign(_chng) == -1) ? _p * 0.25f : _p / (2 * Pi) * Asin(1);
-
-            return _chng * pow(2.0f, -10 * _pos) * sin((_pos * _d - _s) * (2 * Pi) / _p) + _chng + _start;
-        }
+            EaseAll(_pos, _opt1, _opt2, _count, [](float t, float e, float d)
+                    { return EaseOutElastic(t, e, d); });
+            break;
         case TWERP_IN_ELASTIC:
-        {
-            float _s, _p;
-            float _e = _opt1 != Twerp_Undefined ? _opt1 : 0.3f;
-            float _d = _opt2 != Twerp_Undefined ? _opt2 : 5.0f;
-
-            if (_pos == 0 || _chng == 0)
-                return _start;
-            if (_pos == 1)
-                return _end;
-
-            _p = _d * _e;
-            _s = Sign(_chng) == -1 ? _p * 0.25f : _p / (2 * Pi) * Asin(1);
-
-            return -(_chng * pow(2.0f, 10 * (--_pos)) * sin((_pos * _d - _s) * (Pi * 2) / _p)) + _start;
-        }
+            EaseAll(_pos, _opt1, _opt2, _count, [](float t, float e, float d)
+                    { return EaseInElastic(t, e, d); });
+            break;
 
         case TWERP_INOUT_EXPO:
-            return (_pos < .5) ? Twerp(_start, _mid, _pos * 2, TWERP_IN_EXPO)
-                               : Twerp(_mid, _end, (_pos - .5f) * 2, TWERP_OUT_EXPO);
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInOut(t, EaseInExpo(t * 2), EaseOutExpo(t * 2 - 1)); });
+            break;
         case TWERP_OUT_EXPO:
-            return _chng * (-pow(2.0f, -10 * _pos) + 1) + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseOutExpo(t); });
+            break;
         case TWERP_IN_EXPO:
-            return _chng * pow(2.0f, 10 * (_pos - 1)) + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInExpo(t); });
+            break;
 
         case TWERP_INOUT_QUAD:
-            return (_pos < .5) ? Twerp(_start, _mid, _pos * 2, TWERP_IN_QUAD)
-                               : Twerp(_mid, _end, (_pos - .5f) * 2, TWERP_OUT_QUAD);
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInOut(t, EaseInQuad(t * 2), EaseOutQuad(t * 2 - 1)); });
+            break;
         case TWERP_OUT_QUAD:
-            return -_chng * _pos * (_pos - 2) + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseOutQuad(t); });
+            break;
         case TWERP_IN_QUAD:
-            return _chng * _pos * _pos + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInQuad(t); });
+            break;
 
         case TWERP_INOUT_QUART:
-            return (_pos < .5) ? Twerp(_start, _mid, _pos * 2, TWERP_IN_QUART)
-                               : Twerp(_mid, _end, (_pos - .5f) * 2, TWERP_OUT_QUART);
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInOut(t, EaseInQuart(t * 2), EaseOutQuart(t * 2 - 1)); });
+            break;
         case TWERP_OUT_QUART:
-            return -_chng * (((_pos - 1) * (_pos - 1) * (_pos - 1) * (_pos - 1)) - 1) + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseOutQuart(t); });
+            break;
         case TWERP_IN_QUART:
-            return _chng * (_pos * _pos * _pos * _pos) + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInQuart(t); });
+            break;
 
         case TWERP_INOUT_QUINT:
-            return _pos < .5 ? Twerp(_start, _mid, _pos * 2, TWERP_IN_QUINT)
-                             : Twerp(_mid, _end, (_pos - .5f) * 2, TWERP_OUT_QUINT);
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInOut(t, EaseInQuint(t * 2), EaseOutQuint(t * 2 - 1)); });
+            break;
         case TWERP_OUT_QUINT:
-            return _chng * ((_pos - 1) * (_pos - 1) * (_pos - 1) * (_pos - 1) * (_pos - 1) + 1) + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseOutQuint(t); });
+            break;
         case TWERP_IN_QUINT:
-            return _chng * _pos * _pos * _pos * _pos * _pos + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return EaseInQuint(t); });
+            break;
 
         case TWERP_INOUT_SINE:
-            return _chng * 0.5f * (1 - cos(Pi * _pos)) + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return 0.5f * (1 - cosf(Pi * t)); });
+            break;
         case TWERP_OUT_SINE:
-            return _chng * sin(_pos * Pi / 2.0f) + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return sinf(t * Pi / 2.0f); });
+            break;
         case TWERP_IN_SINE:
-            return _chng * (1 - cos(_pos * Pi / 2.0f)) + _start;
+            EaseAll(_pos, _count, [](float t)
+                    { return 1 - cosf(t * Pi / 2.0f); });
+            break;
 
         default:
-            return 0;
+            break;
+        }
+    }
+
+    float TwerpEase(TwerpType _type, float _pos, float _opt1, float _opt2)
+    {
+        TwerpEaseBatch(_type, &_pos, &_opt1, &_opt2, 1);
+        return _pos;
+    }
+
+    void TwerpDefaultOptions(TwerpType _type, float &_opt1, float &_opt2)
+    {
+        switch (_type)
+        {
+        case TWERP_INOUT_BACK:
+        case TWERP_IN_BACK:
+        case TWERP_OUT_BACK:
+            if (_opt1 == Twerp_Undefined)
+                _opt1 = Twerp_Back_DefaultBounciness;
+            break;
+        case TWERP_INOUT_ELASTIC:
+        case TWERP_IN_ELASTIC:
+        case TWERP_OUT_ELASTIC:
+            if (_opt1 == Twerp_Undefined)
+                _opt1 = 0.3f;
+            if (_opt2 == Twerp_Undefined)
+                _opt2 = 5.0f;
+            break;
+        default:
+            break;
         }
     }
 
     float Twerp(float _start, float _end, float _pos, TwerpType _type, bool _looped, float _opt1, float _opt2)
     {
-        return _TwerpHelper(_start, _end, _pos, _type, _looped, _opt1, _opt2);
+        if (_type < 0 || _type >= TwerpType::TWERP_COUNT)
+            return 0.0f;
+
+        _pos = Clamp<float>(_looped ? fmod(_pos, 1.0f) : _pos, 0.0f, 1.0f);
+        TwerpDefaultOptions(_type, _opt1, _opt2);
+        return _start + (_end - _start) * TwerpEase(_type, _pos, _opt1, _opt2);
     }
     int Twerp(int _start, int _end, float _pos, TwerpType _type, bool _looped, float _opt1, float _opt2)
     {
-        return (int)_TwerpHelper((float)_start, (float)_end, _pos, _type, _looped, _opt1, _opt2);
+        return (int)Twerp((float)_start, (float)_end, _pos, _type, _looped, _opt1, _opt2);
     }
     Uint8 Twerp(Uint8 _start, Uint8 _end, float _pos, TwerpType _type, bool _looped, float _opt1, float _opt2)
     {
-        return (Uint8)_TwerpHelper((float)_start, (float)_end, _pos, _type, _looped, _opt1, _opt2);
+        return (Uint8)Twerp((float)_start, (float)_end, _pos, _type, _looped, _opt1, _opt2);
     }
 
-    void TwerpAsync(Actor *actor, float &value, float start, float end, float time, TwerpType type, bool looped, float opt1, float opt2)
+    TwerpId TwerpAsync(Actor *actor, float &value, float start, float end, float time, TwerpType type, bool looped, float opt1, float opt2)
     {
-        TwerpPropertyFloat prop = {&(value), start, end, time, 0.0f, type, looped, opt1, opt2};
         Game *game = Game::Get();
-        if (game)
-        {
-            game->RegisterTwerpAsync(actor, prop, game->GetTwerpAsyncsFloat());
-            value = start;
-        }
+        return game ? game->GetTwerps().Add(actor, value, start, end, time, type, looped, opt1, opt2) : kNoTwerp;
     }
-    void TwerpAsync(Actor *actor, int &value, int start, int end, float time, TwerpType type, bool looped, float opt1, float opt2)
+    TwerpId TwerpAsync(Actor *actor, int &value, int start, int end, float time, TwerpType type, bool looped, float opt1, float opt2)
     {
-        TwerpPropertyInt prop = {&(value), start, end, time, 0.0f, type, looped, opt1, opt2};
         Game *game = Game::Get();
-        if (game)
-        {
-            game->RegisterTwerpAsync(actor, prop, game->GetTwerpAsyncsInt());
-            value = start;
-        }
+        return game ? game->GetTwerps().Add(actor, value, start, end, time, type, looped, opt1, opt2) : kNoTwerp;
     }
-    void TwerpAsync(Actor *actor, Uint8 &value, Uint8 start, Uint8 end, float time, TwerpType type, bool looped, float opt1, float opt2)
+    TwerpId TwerpAsync(Actor *actor, Uint8 &value, Uint8 start, Uint8 end, float time, TwerpType type, bool looped, float opt1, float opt2)
     {
-        TwerpPropertyUint8 prop = {&(value), start, end, time, 0.0f, type, looped, opt1, opt2};
         Game *game = Game::Get();
-        if (game)
-        {
-            game->RegisterTwerpAsync(actor, prop, game->GetTwerpAsyncsUint8());
-            value = start;
-        }
+        return game ? game->GetTwerps().Add(actor, value, start, end, time, type, looped, opt1, opt2) : kNoTwerp;
+    }
+    TwerpId TwerpAsync(Actor *actor, Vec2<float> &value, Vec2<float> start, Vec2<float> end, float time, TwerpType type, bool looped, float opt1, float opt2)
+    {
+        Game *game = Game::Get();
+        return game ? game->GetTwerps().Add(actor, value, start, end, time, type, looped, opt1, opt2) : kNoTwerp;
     }
-    // Probably should make this better since it's a bit of a hack
-    void TwerpAsync(Actor *actor, Vec2<float> &value, Vec2<float> start, Vec2<float> end, float time, TwerpType type, bool looped, float opt1, float opt2)
+    TwerpId TwerpAsync(Actor *actor, Color &value, Color start, Color end, float time, TwerpType type, bool looped, float opt1, float opt2)
     {
-        TwerpAsync(actor, value.x, start.x, end.x, time, type, looped, opt1, opt2);
-        TwerpAsync(actor, value.y, start.y, end.y, time, type, looped, opt1, opt2);
+        Game *game = Game::Get();
+        return game ? game->GetTwerps().Add(actor, value, start, end, time, type, looped, opt1, opt2) : kNoTwerp;
     }
-    void TwerpAsync(Actor *actor, Vec2<int> &value, Vec2<int> start, Vec2<int> end, float time, TwerpType type, bool looped, float opt1, float opt2)
+    TwerpId TwerpPositionAsync(VisualActor *actor, Vec2<float> start, Vec2<float> end, float time, TwerpType type, bool looped, float opt1, float opt2)
     {
-        TwerpAsync(actor, value.x, start.x, end.x, time, type, looped, opt1, opt2);
-        TwerpAsync(actor, value.y, start.y, end.y, time, type, looped, opt1, opt2);
+        Game *game = Game::Get();
+        return game ? game->GetTwerps().AddPosition(actor, start, end, time, type, looped, opt1, opt2) : kNoTwerp;
     }
 
     bool ToggleTwerpAsync(Actor *actor, float &value, int forceState)
     {
-        TwerpPropertyFloat prop = {&(value)};
         Game *game = Game::Get();
-        if (game)
-            return game->ToggleTwerpAsync(actor, prop, game->GetTwerpAsyncsFloat(), forceState);
-        return false;
+        return game && game->GetTwerps().Toggle(actor, value, forceState);
     }
     bool ToggleTwerpAsync(Actor *actor, int &value, int forceState)
     {
-        TwerpPropertyInt prop = {&(value)};
         Game *game = Game::Get();
-        if (game)
-            return game->ToggleTwerpAsync(actor, prop, game->GetTwerpAsyncsInt(), forceState);
-        return false;
+        return game && game->GetTwerps().Toggle(actor, value, forceState);
     }
     bool ToggleTwerpAsync(Actor *actor, Uint8 &value, int forceState)
     {
-        TwerpPropertyUint8 prop = {&(value)};
         Game *game = Game::Get();
-        if (game)
-            return game->ToggleTwerpAsync(actor, prop, game->GetTwerpAsyncsUint8(), forceState);
-        return false;
+        return game && game->GetTwerps().Toggle(actor, value, forceState);
     }
     bool ToggleTwerpAsync(Actor *actor, Vec2<float> &value, int forceState)
     {
-        return ToggleTwerpAsync(actor, value.x, forceState) && ToggleTwerpAsync(actor, value.y, forceState);
+        Game *game = Game::Get();
+        return game && game->GetTwerps().Toggle(actor, value, forceState);
+    }
+    bool ToggleTwerpAsync(Actor *actor, Color &value, int forceState)
+    {
+        Game *game = Game::Get();
+        return game && game->GetTwerps().Toggle(actor, value, forceState);
     }
-    bool ToggleTwerpAsync(Actor *actor, Vec2<int> &value, int forceState)
+    bool ToggleTwerpAsync(TwerpId id, int forceState)
     {
-        return ToggleTwerpAsync(actor, value.x, forceState) && ToggleTwerpAsync(actor, value.y, forceState);
+        Game *game = Game::Get();
+        return game && game->GetTwerps().Toggle(id, forceState);
     }
 
     bool StopTwerpAsync(Actor *actor, float &value)
     {
-        TwerpPropertyFloat prop = {&(value)};
         Game *game = Game::Get();
-        if (game)
-            return game->StopTwerpAsync(actor, prop, game->GetTwerpAsyncsFloat());
-        return false;
+        return game && game->GetTwerps().Stop(actor, value);
     }
     bool StopTwerpAsync(Actor *actor, int &value)
     {
-        TwerpPropertyInt prop = {&(value)};
         Game *game = Game::Get();
-        if (game)
-            return game->StopTwerpAsync(actor, prop, game->GetTwerpAsyncsInt());
-        return false;
+        return game && game->GetTwerps().Stop(actor, value);
     }
     bool StopTwerpAsync(Actor *actor, Uint8 &value)
     {
-        TwerpPropertyUint8 prop = {&(value)};
         Game *game = Game::Get();
-        if (game)
-            return game->StopTwerpAsync(actor, prop, game->GetTwerpAsyncsUint8());
-        return false;
+        return game && game->GetTwerps().Stop(actor, value);
     }
     bool StopTwerpAsync(Actor *actor, Vec2<float> &value)
     {
-        return StopTwerpAsync(actor, value.x) && StopTwerpAsync(actor, value.y);
+        Game *game = Game::Get();
+        return game && game->GetTwerps().Stop(actor, value);
+    }
+    bool StopTwerpAsync(Actor *actor, Color &value)
+    {
+        Game *game = Game::Get();
+        return game && game->GetTwerps().Stop(actor, value);
     }
-    bool StopTwerpAsync(Actor *actor, Vec2<int> &value)
+    bool StopTwerpAsync(TwerpId id)
     {
-        return StopTwerpAsync(actor, value.x) && StopTwerpAsync(actor, value.y);
+        Game *game = Game::Get();
+        return game && game->GetTwerps().Stop(id);
     }
 }
 
@@ -294,7 +427,5 @@ using namespace junebug;
 
 void Game::UpdateTwerps(float dt)
 {
-    UpdateTwerpList(mTwerpAsyncsFloat, dt);
-    UpdateTwerpList(mTwerpAsyncsInt, dt);
-    UpdateTwerpList(mTwerpAsyncsUint8, dt);
+    mTwerps.Update(dt);
 }
\ No newline at end of file
@@ -17,9 +17,30 @@ Actor::~Actor()
     Game::Get()->RemoveActor(this);
 }
 
+void Actor::SetDepth(int newDepth)
+{
+    if (newDepth == mDepth)
+        return;
+    mDepth = newDepth;
+
+    Game *game = Game::Get();
+    if (mInActorList && game)
+        game->MarkActorOrderDirty();
+}
+
+void Actor::SetId(std::string id)
+{
+    Game *game = Game::Get();
+    if (mInActorList && game)
+        game->SetActorId(this, id);
+    else
+        mId = id;
+}
+
 void Actor::AddComponent(Component<> *c)
 {
-    mComponents.emplace_back(c);
-    std::sort(mComponents.begin(), mComponents.end(), [](Component<> *a, Component<> *b)
-              { return a->GetUpdateOrder() < b->GetUpdateOrder(); });
+    // Keep the list sorted by inserting after every component with the same or an earlier update order
+    auto it = std::upper_bound(mComponents.begin(), mComponents.end(), c, [](Component<> *a, Component<> *b)
+                               { return a->GetUpdateOrder() < b->GetUpdateOrder(); });
+    mComponents.insert(it, c);
 }
\ No newline at end of file
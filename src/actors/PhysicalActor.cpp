@@ -38,7 +38,7 @@ void PhysicalActor::InitializeComponents()
         switch (mCollType)
         {
         case CollType::Polygon:
-            mColl = new PolygonCollider(this, mCollLayer);
+            mColl = Game::Get()->CreateComponent<PolygonCollider>(this, mCollLayer);
             break;
         default:
             break;
@@ -162,7 +162,7 @@ void PhysicalActor::SetCollType(CollType type)
 void PhysicalActor::InitializePhysComponent()
 {
     if (!mPhys)
-        mPhys = new Rigidbody(this, mColl);
+        mPhys = Game::Get()->CreateComponent<Rigidbody>(this, mColl);
     else
         mPhys->SetCollComponent(mColl);
 }
\ No newline at end of file
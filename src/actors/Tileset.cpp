@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Tileset.h"
 #include "Camera.h"
 #include "Sprite.h"
@@ -6,6 +8,54 @@
 
 using namespace junebug;
 
+TileGrid::TileGrid(int width, int height, int fill) : mWidth(std::max(width, 0)), mHeight(std::max(height, 0))
+{
+    mTiles.assign((size_t)mWidth * mHeight, fill);
+}
+
+TileGrid::TileGrid(int width, int height, std::vector<int> tiles) : mWidth(std::max(width, 0)), mHeight(std::max(height, 0)), mTiles(std::move(tiles))
+{
+    mTiles.resize((size_t)mWidth * mHeight, -1);
+}
+
+TileGrid::TileGrid(const std::vector<std::vector<int>> &rows)
+{
+    int width = 0;
+    for (auto &row : rows)
+        width = std::max(width, (int)row.size());
+
+    mWidth = width;
+    mHeight = (int)rows.size();
+    mTiles.assign((size_t)mWidth * mHeight, -1);
+    for (int y = 0; y < mHeight; y++)
+        std::copy(rows[y].begin(), rows[y].end(), mTiles.begin() + (size_t)y * mWidth);
+}
+
+void TileGrid::Resize(int width, int height, int fill)
+{
+    width = std::max(width, 0);
+    height = std::max(height, 0);
+    if (width == mWidth && height == mHeight)
+        return;
+
+    if (width == mWidth)
+    {
+        // Rows keep their layout, so only the tail changes
+        mTiles.resize((size_t)width * height, fill);
+    }
+    else
+    {
+        std::vector<int> tiles((size_t)width * height, fill);
+        int copyWidth = std::min(width, mWidth), copyHeight = std::min(height, mHeight);
+        for (int y = 0; y < copyHeight; y++)
+            std::copy_n(mTiles.begin() + (size_t)y * mWidth, copyWidth, tiles.begin() + (size_t)y * width);
+        mTiles.swap(tiles);
+    }
+
+    mWidth = width;
+    mHeight = height;
+}
+
 Tileset::Tileset(std::string sprite, Vec2<int> tileSize, Vec2<float> pos) : VisualActor(pos, sprite)
 {
     if (tileSize.x <= 0 || tileSize.y <= 0)
@@ -14,6 +64,11 @@ Tileset::Tileset(std::string sprite, Vec2<int> tileSize, Vec2<float> pos) : Visu
         mTileSize = tileSize;
 }
 
+Tileset::~Tileset()
+{
+    ClearChunks();
+}
+
 void Tileset::InternalFirstUpdate(float dt)
 {
     // Set the offset to the sprite's origin
@@ -29,12 +84,12 @@ void Tileset::InternalFirstUpdate(float dt)
     Game *game = Game::Get();
     if (game)
     {
-        game->SetInputMappings({mDrawInput,
-                                mEraseInput,
-                                mRotateCWInput,
-                                mRotateCCWInput,
-                                mFlipXInput,
-                                mFlipYInput});
+        mDrawAction = game->SetInputMapping(mDrawInput.first, mDrawInput.second);
+        mEraseAction = game->SetInputMapping(mEraseInput.first, mEraseInput.second);
+        mRotateCWAction = game->SetInputMapping(mRotateCWInput.first, mRotateCWInput.second);
+        mRotateCCWAction = game->SetInputMapping(mRotateCCWInput.first, mRotateCCWInput.second);
+        mFlipXAction = game->SetInputMapping(mFlipXInput.first, mFlipXInput.second);
+        mFlipYAction = game->SetInputMapping(mFlipYInput.first, mFlipYInput.second);
     }
 
     if (mNumTiles == -1)
@@ -56,17 +111,17 @@ void Tileset::InternalUpdate(float dt)
     bool changed = false;
     if (mEditMode != TilesetEditMode::None)
     {
-        mDrawAngle = (mDrawAngle + InputsPressedDir(mRotateCWInput, mRotateCCWInput) * 90) % 360;
+        mDrawAngle = (mDrawAngle + InputsPressedDir(mRotateCWAction, mRotateCCWAction) * 90) % 360;
         if (mDrawAngle < 0)
             mDrawAngle += 360;
-        if (InputPressed(mFlipXInput))
+        if (InputPressed(mFlipXAction))
             mDrawFlip.x *= -1;
-        if (InputPressed(mFlipYInput))
+        if (InputPressed(mFlipYAction))
             mDrawFlip.y *= -1;
 
-        if (Input(mDrawInput))
+        if (Input(mDrawAction))
             changed = SetWorldTile(Game::Get()->GetMousePos(), TransformTile(mDrawTile, mDrawAngle, mDrawFlip));
-        else if (Input(mEraseInput))
+        else if (Input(mEraseAction))
             changed = SetWorldTile(Game::Get()->GetMousePos(), -1);
     }
 
@@ -79,12 +134,28 @@ void Tileset::InternalUpdate(float dt)
             if (actor)
             {
                 auto &allocator = json->GetDoc()->GetAllocator();
+                // Trailing empty tiles are trimmed to keep the scene file small
+                int height = mTiles.GetHeight();
+                while (height > 0)
+                {
+                    TileRow r = mTiles.Row(height - 1);
+                    if (std::any_of(r.begin(), r.end(), [](int tile)
+                                    { return tile != -1; }))
+                        break;
+                    height--;
+                }
+
                 Value tiles(kArrayType);
-                for (std::vector<int> &r : mTiles)
+                for (int y = 0; y < height; y++)
                 {
+                    TileRow r = mTiles.Row(y);
+                    int width = r.size;
+                    while (width > 0 && r[width - 1] == -1)
+                        width--;
+
                     Value row(kArrayType);
-                    for (int tile : r)
-                        row.PushBack(tile, allocator);
+                    for (int x = 0; x < width; x++)
+                        row.PushBack(r[x], allocator);
                     tiles.PushBack(row, allocator);
                 }
 
@@ -99,48 +170,289 @@ void Tileset::InternalUpdate(float dt)
 void Tileset::Draw()
 {
     Vec2<int> sprSize = GetSpriteSize(), partPos;
-    if (sprSize.x <= 0 || sprSize.y <= 0)
+    if (sprSize.x <= 0 || sprSize.y <= 0 || mNumTiles <= 0)
+        return;
+
+    Game *game = Game::Get();
+    Camera *cam = game->GetActiveCamera();
+    if (!cam)
         return;
 
+    // Only tiles inside the camera's view are drawn
+    Vec2<int> min, max;
+    GetCullBounds(cam->GetPosition(), cam->GetBottomRight(), min, max);
+
+    if (mChunkCaching && SDL_RenderTargetSupported(game->GetRenderer()))
+        DrawChunks(min, max, sprSize);
+    else
+        DrawTileRange(min, max, sprSize);
+
+    if (mEditMode != TilesetEditMode::None)
+    {
+        Vec2<int> tile = WorldToTile(game->GetMousePos());
+
+        partPos = GetTilePartPos(mDrawTile, sprSize);
+        DrawSpritePart(mSpriteHandle, 0, TileToWorld(tile), partPos, mTileSize, {mScale * mDrawFlip, (float)mDrawAngle, Color(100, 100, 255, 100)});
+    }
+}
+
+Vec2<int> Tileset::GetTilePartPos(int tile, const Vec2<int> &sprSize)
+{
+    int baseTile = tile % mNumTiles;
+    return Vec2<int>((baseTile % (sprSize.x / mTileSize.x)) * mTileSize.x,
+                     (baseTile / (sprSize.y / mTileSize.y)) * mTileSize.y);
+}
+
+void Tileset::DrawTileRange(const Vec2<int> &min, const Vec2<int> &max, const Vec2<int> &sprSize)
+{
     float tileGameWidth = GetTileWidth(), tileGameHeight = GetTileHeight();
-    Vec2<float> pos = GetPosition().Round(mSpacingRoundDir);
-    float startX = pos.x;
+    Vec2<float> start = GetPosition().Round(mSpacingRoundDir);
 
     int angle = 0;
     Vec2<int> flip;
-
-    for (std::vector<int> &r : mTiles)
+    for (int y = min.y; y <= max.y; y++)
     {
-        for (int tile : r)
+        TileRow row = mTiles.Row(y);
+        Vec2<float> pos(start.x + min.x * tileGameWidth, start.y + y * tileGameHeight);
+        for (int x = min.x; x <= max.x; x++, pos.x += tileGameWidth)
         {
+            int tile = row[x];
             if (tile < 0)
+                continue;
+
+            GetTileTransform(tile, angle, flip);
+            DrawSpritePart(
+                mSpriteHandle, 0, pos, GetTilePartPos(tile, sprSize), mTileSize, {mScale * flip, (float)angle, mColor});
+        }
+    }
+}
+
+void Tileset::DrawChunks(const Vec2<int> &min, const Vec2<int> &max, const Vec2<int> &sprSize)
+{
+    Game *game = Game::Get();
+    SDL_Renderer *renderer = game->GetRenderer();
+
+    // Anything that changes how tiles look invalidates every chunk
+    if (mChunkSprite != mSpriteHandle || mChunkTileSize != mTileSize || mChunkTargetResets != game->GetRenderTargetResets())
+    {
+        ClearChunks();
+        mChunkSprite = mSpriteHandle;
+        mChunkTileSize = mTileSize;
+        mChunkTargetResets = game->GetRenderTargetResets();
+    }
+
+    Vec2<int> chunkCount((mTiles.GetWidth() + kChunkSize - 1) / kChunkSize, (mTiles.GetHeight() + kChunkSize - 1) / kChunkSize);
+    if (chunkCount != mChunkCount)
+    {
+        ClearChunks();
+        mChunkCount = chunkCount;
+        mChunks.resize((size_t)mChunkCount.x * mChunkCount.y);
+    }
+
+    unsigned long frame = game->GetFrameCount();
+    if (frame != mChunkEvictFrame)
+    {
+        mChunkEvictFrame = frame;
+        EvictChunks(frame);
+    }
+
+    // Nothing is visible when the camera is past the edge of the map
+    if (min.x > max.x || min.y > max.y)
+        return;
+
+    float tileGameWidth = GetTileWidth(), tileGameHeight = GetTileHeight();
+    Vec2<float> start = GetPosition().Round(mSpacingRoundDir) - Vec2<float>(GetSprite()->GetOrigin()) * mScale;
+
+    for (int cy = min.y / kChunkSize; cy <= max.y / kChunkSize && cy < mChunkCount.y; cy++)
+    {
+        for (int cx = min.x / kChunkSize; cx <= max.x / kChunkSize && cx < mChunkCount.x; cx++)
+        {
+            uint32_t index = (uint32_t)cy * mChunkCount.x + cx;
+            TileChunk &chunk = mChunks[index];
+            chunk.lastDrawn = frame;
+            bool hadTexture = chunk.texture != nullptr;
+            bool baked = !chunk.dirty || BakeChunk(chunk, Vec2<int>(cx, cy), sprSize);
+            if (!hadTexture && chunk.texture)
+                mBakedChunks.push_back(index);
+            if (!baked)
             {
-                pos.x += tileGameWidth;
+                // Baking failed, so fall back to drawing the chunk's tiles directly
+                Vec2<int> chunkMin(cx * kChunkSize, cy * kChunkSize);
+                Vec2<int> chunkMax(Min(chunkMin.x + kChunkSize - 1, max.x), Min(chunkMin.y + kChunkSize - 1, max.y));
+                DrawTileRange(Vec2<int>::Max(chunkMin, min), chunkMax, sprSize);
                 continue;
             }
+            if (chunk.empty)
+                continue;
 
-            int baseTile = tile % mNumTiles;
-            partPos.x = (baseTile % (sprSize.x / mTileSize.x)) * mTileSize.x;
-            partPos.y = (baseTile / (sprSize.y / mTileSize.y)) * mTileSize.y;
+            // Both edges are rounded, so neighbouring chunks share an edge and leave no seams at any zoom
+            // A flipped tileset lays its tiles out backwards from the start, one tile over, like the per-tile path does
+            Vec2<float> edge1 = start + Vec2<float>(cx * kChunkSize * tileGameWidth, cy * kChunkSize * tileGameHeight);
+            Vec2<float> edge2 = edge1 + Vec2<float>(kChunkSize * tileGameWidth, kChunkSize * tileGameHeight);
+            Vec2<float> flipOffset(Max(-tileGameWidth, 0.0f), Max(-tileGameHeight, 0.0f));
+            Vec2<float> topLeft = GetDrawPosition(Vec2<float>::Min(edge1, edge2) + flipOffset);
+            Vec2<float> bottomRight = GetDrawPosition(Vec2<float>::Max(edge1, edge2) + flipOffset);
+
+            RenderCommand command;
+            command.texture = chunk.texture;
+            command.src = {0, 0, kChunkSize * mTileSize.x, kChunkSize * mTileSize.y};
+            command.dest.x = static_cast<int>(round(topLeft.x));
+            command.dest.y = static_cast<int>(round(topLeft.y));
+            command.dest.w = static_cast<int>(round(bottomRight.x)) - command.dest.x;
+            command.dest.h = static_cast<int>(round(bottomRight.y)) - command.dest.y;
+            command.flip = (SDL_RendererFlip)((mScale.x < 0 ? SDL_FLIP_HORIZONTAL : 0) | (mScale.y < 0 ? SDL_FLIP_VERTICAL : 0));
+            command.color = mColor;
+
+            if (game->GetOptions().batchSprites)
+                game->GetRenderQueue().Submit(command);
+            else
+            {
+                SDL_SetTextureColorMod(chunk.texture, mColor.r, mColor.g, mColor.b);
+                SDL_SetTextureAlphaMod(chunk.texture, mColor.a);
+                SDL_RenderCopyEx(renderer, chunk.texture, &command.src, &command.dest, 0.0, nullptr, command.flip);
+            }
+        }
+    }
+}
 
-            GetTileTransform(tile, angle, flip);
+bool Tileset::BakeChunk(TileChunk &chunk, const Vec2<int> &chunkPos, const Vec2<int> &sprSize)
+{
+    SDL_Renderer *renderer = Game::Get()->GetRenderer();
+    Sprite *sprite = GetSprite();
+    if (!renderer || !sprite || sprite->GetFrames().empty() || !sprite->GetFrames()[0].texture)
+        return false;
+    // The tile sheet may be packed into an atlas page, so source rects are offset by its region
+    const TextureRegion &tileFrame = sprite->GetFrames()[0];
+    SDL_Texture *tileTex = tileFrame.texture;
 
-            DrawSpritePart(
-                mSpritePath, 0, pos, partPos, mTileSize, {mScale * flip, (float)angle, mColor});
-            pos.x += tileGameWidth;
+    Vec2<int> min(chunkPos.x * kChunkSize, chunkPos.y * kChunkSize);
+    Vec2<int> max(Min(min.x + kChunkSize, mTiles.GetWidth()) - 1, Min(min.y + kChunkSize, mTiles.GetHeight()) - 1);
+
+    chunk.empty = true;
+    for (int y = min.y; y <= max.y && chunk.empty; y++)
+    {
+        TileRow row = mTiles.Row(y);
+        for (int x = min.x; x <= max.x; x++)
+        {
+            if (row[x] >= 0)
+            {
+                chunk.empty = false;
+                break;
+            }
         }
-        pos.y += tileGameHeight;
-        pos.x = startX;
+    }
+    if (chunk.empty)
+    {
+        chunk.dirty = false;
+        return true;
     }
 
-    if (mEditMode != TilesetEditMode::None)
+    if (!chunk.texture)
+    {
+        chunk.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, kChunkSize * mTileSize.x, kChunkSize * mTileSize.y);
+        if (!chunk.texture)
+            return false;
+        SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+    }
+
+    // Save the renderer state, since chunks are baked in the middle of a camera's render
+    // Anything already queued belongs to the camera's target, so it has to be drawn before switching
+    Game::Get()->FlushRenderQueue();
+    SDL_Texture *prevTarget = SDL_GetRenderTarget(renderer);
+    SDL_Rect prevViewport;
+    SDL_RenderGetViewport(renderer, &prevViewport);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_BlendMode prevBlend;
+    SDL_GetTextureBlendMode(tileTex, &prevBlend);
+
+    SDL_SetRenderTarget(renderer, chunk.texture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    // Tiles never overlap, so copy them as-is and let the chunk blend when it's drawn
+    SDL_SetTextureBlendMode(tileTex, SDL_BLENDMODE_NONE);
+    SDL_SetTextureColorMod(tileTex, 255, 255, 255);
+    SDL_SetTextureAlphaMod(tileTex, 255);
+
+    int angle = 0;
+    Vec2<int> flip;
+    for (int y = min.y; y <= max.y; y++)
+    {
+        TileRow row = mTiles.Row(y);
+        for (int x = min.x; x <= max.x; x++)
+        {
+            int tile = row[x];
+            if (tile < 0)
+                continue;
+
+            Vec2<int> partPos = GetTilePartPos(tile, sprSize);
+            SDL_Rect src = {tileFrame.rect.x + partPos.x, tileFrame.rect.y + partPos.y, mTileSize.x, mTileSize.y};
+            SDL_Rect dest = {(x - min.x) * mTileSize.x, (y - min.y) * mTileSize.y, mTileSize.x, mTileSize.y};
+
+            GetTileTransform(tile, angle, flip);
+            if (flip.x < 0 && flip.y < 0)
+                SDL_RenderCopyEx(renderer, tileTex, &src, &dest, -angle + 180.0f, nullptr, SDL_FLIP_NONE);
+            else
+                SDL_RenderCopyEx(renderer, tileTex, &src, &dest, -angle, nullptr,
+                                 (flip.x < 0) ? SDL_FLIP_HORIZONTAL : (flip.y < 0) ? SDL_FLIP_VERTICAL
+                                                                                   : SDL_FLIP_NONE);
+        }
+    }
+
+    SDL_SetTextureBlendMode(tileTex, prevBlend);
+    SDL_SetRenderTarget(renderer, prevTarget);
+    SDL_RenderSetViewport(renderer, &prevViewport);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+
+    chunk.dirty = false;
+    return true;
+}
+
+void Tileset::DirtyChunk(const Vec2<int> &tilePos)
+{
+    Vec2<int> chunkPos(tilePos.x / kChunkSize, tilePos.y / kChunkSize);
+    if (chunkPos.x < mChunkCount.x && chunkPos.y < mChunkCount.y)
+        mChunks[(size_t)chunkPos.y * mChunkCount.x + chunkPos.x].dirty = true;
+}
+
+void Tileset::ClearChunks()
+{
+    for (TileChunk &chunk : mChunks)
     {
-        Vec2<int> tile = WorldToTile(Game::Get()->GetMousePos());
+        if (chunk.texture)
+            SDL_DestroyTexture(chunk.texture);
+    }
+    mChunks.clear();
+    mBakedChunks.clear();
+    mChunkCount = Vec2<int>::Zero;
+}
 
-        partPos.x = (mDrawTile % (sprSize.x / mTileSize.x)) * mTileSize.x;
-        partPos.y = (mDrawTile / (sprSize.y / mTileSize.y)) * mTileSize.y;
-        DrawSpritePart(mSpritePath, 0, TileToWorld(tile), partPos, mTileSize, {mScale * mDrawFlip, (float)mDrawAngle, Color(100, 100, 255, 100)});
+void Tileset::EvictChunks(unsigned long frame)
+{
+    auto evict = [this](size_t i)
+    {
+        TileChunk &chunk = mChunks[mBakedChunks[i]];
+        SDL_DestroyTexture(chunk.texture);
+        chunk.texture = nullptr;
+        chunk.dirty = true;
+        mBakedChunks[i] = mBakedChunks.back();
+        mBakedChunks.pop_back();
+    };
+
+    for (size_t i = mBakedChunks.size(); i > 0; i--)
+    {
+        if (frame - mChunks[mBakedChunks[i - 1]].lastDrawn > kChunkIdleFrames)
+            evict(i - 1);
     }
+    if (mBakedChunks.size() <= kMaxBakedChunks)
+        return;
+
+    // Over the cap, the chunks drawn longest ago go first, but never ones drawn last frame
+    std::sort(mBakedChunks.begin(), mBakedChunks.end(), [this](uint32_t a, uint32_t b)
+              { return mChunks[a].lastDrawn > mChunks[b].lastDrawn; });
+    while (mBakedChunks.size() > kMaxBakedChunks && frame - mChunks[mBakedChunks.back()].lastDrawn > 1)
+        evict(mBakedChunks.size() - 1);
 }
 
 Vec2<int> Tileset::WorldToTile(Vec2<float> pos)
@@ -164,46 +476,40 @@ Vec2<float> Tileset::TileToWorld(Vec2<int> pos)
     return ret;
 }
 
+void Tileset::SetTiles(TileGrid tiles)
+{
+    mTiles = std::move(tiles);
+    ClearChunks();
+    if (mColl)
+        mColl->MarkAllDirty();
+}
+
 bool Tileset::SetTile(Vec2<int> tilePos, int tile)
 {
     if (tilePos.x < 0 || tilePos.y < 0)
         return false;
 
-    if (tile == -1)
+    if (!mTiles.InBounds(tilePos.x, tilePos.y))
     {
-        if (mTiles.size() <= tilePos.y || mTiles[tilePos.y].size() <= tilePos.x)
+        // Erasing outside of the grid is a no-op
+        if (tile == -1)
             return false;
-
-        mTiles[tilePos.y][tilePos.x] = -1;
-        if (tilePos.x == mTiles[tilePos.y].size() - 1)
-        {
-            while (mTiles[tilePos.y].size() > 0 && mTiles[tilePos.y].back() == -1)
-                mTiles[tilePos.y].pop_back();
-            while (mTiles.size() > 0 && mTiles.back().size() == 0)
-                mTiles.pop_back();
-        }
-
-        return true;
+        mTiles.Resize(std::max(mTiles.GetWidth(), tilePos.x + 1), std::max(mTiles.GetHeight(), tilePos.y + 1));
     }
-    else
-    {
-        while (mTiles.size() <= tilePos.y)
-            mTiles.push_back(std::vector<int>());
-        while (mTiles[tilePos.y].size() <= tilePos.x)
-            mTiles[tilePos.y].push_back(-1);
-        if (mTiles[tilePos.y][tilePos.x] == tile)
-            return false;
 
-        mTiles[tilePos.y][tilePos.x] = tile;
-        return true;
-    }
+    if (mTiles.Get(tilePos) == tile)
+        return false;
+
+    mTiles.Set(tilePos.x, tilePos.y, tile);
+    DirtyChunk(tilePos);
+    if (mColl)
+        mColl->MarkTileDirty(tilePos);
+    return true;
 }
 
 int Tileset::GetTile(Vec2<int> tilePos)
 {
-    if (tilePos.x < 0 || tilePos.y < 0 || tilePos.y >= mTiles.size() || tilePos.x >= mTiles[tilePos.y].size())
-        return -1;
-    return mTiles[tilePos.y][tilePos.x];
+    return mTiles.Get(tilePos);
 }
 
 float Tileset::GetTileWidth()
@@ -224,7 +530,7 @@ void Tileset::EnableCollision()
     }
 
     if (!mColl)
-        mColl = new TileCollider(this, mColliders, mCollLayer);
+        mColl = Game::Get()->CreateComponent<TileCollider>(this, mColliders, mCollLayer);
 
     mColl->SetType(mCollType);
 }
@@ -236,9 +542,9 @@ void Tileset::DisableCollision()
 
 VerticesPtr *Tileset::GetTileCollider(Vec2<int> tile)
 {
-    if (mNumTiles == 0 || tile.x < 0 || tile.y < 0 || tile.y >= mTiles.size() || tile.x >= mTiles[tile.y].size())
+    if (mNumTiles <= 0 || !mTiles.InBounds(tile.x, tile.y))
         return nullptr;
-    int tileNum = mTiles[tile.y][tile.x], baseTile = tileNum % mNumTiles;
+    int tileNum = mTiles.Get(tile), baseTile = tileNum % mNumTiles;
     if (tileNum < 0 || baseTile >= mColliders.size())
         return nullptr;
     return &mColliders[baseTile];
@@ -246,9 +552,9 @@ VerticesPtr *Tileset::GetTileCollider(Vec2<int> tile)
 
 bool Tileset::TileHasCollider(Vec2<int> tile)
 {
-    if (tile.x < 0 || tile.y < 0 || tile.y >= mTiles.size() || tile.x >= mTiles[tile.y].size())
+    if (mNumTiles <= 0 || !mTiles.InBounds(tile.x, tile.y))
         return false;
-    int tileNum = mTiles[tile.y][tile.x], baseTile = tileNum % mNumTiles;
+    int tileNum = mTiles.Get(tile), baseTile = tileNum % mNumTiles;
     if (tileNum < 0 || baseTile >= mColliders.size())
         return false;
     return mColliders[baseTile]->empty();
@@ -280,8 +586,9 @@ void Tileset::GetTileTransform(int tile, int &angle, Vec2<int> &flipped)
 void Tileset::GetCullBounds(const Vec2<float> &startPos, const Vec2<float> &endPos, Vec2<int> &min, Vec2<int> &max)
 {
     Vec2<float> start = (startPos - GetPosition()) / Vec2<float>(GetTileSize() * GetScale()), end = (endPos - GetPosition()) / Vec2<float>(GetTileSize() * GetScale());
-    min.x = std::max((int)floor(start.x), 0);
-    min.y = Clamp((int)floor(start.y), 0, (int)mTiles.size()); // Allows loops to fully skip if the start is out of bounds
-    max.x = (int)ceil(end.x);
-    max.y = Clamp((int)ceil(end.y), 0, (int)mTiles.size() - 1);
+    // Min is clamped to the grid size so loops fully skip if the start is out of bounds
+    min.x = Clamp((int)floor(start.x), 0, mTiles.GetWidth());
+    min.y = Clamp((int)floor(start.y), 0, mTiles.GetHeight());
+    max.x = Clamp((int)ceil(end.x), -1, mTiles.GetWidth() - 1);
+    max.y = Clamp((int)ceil(end.y), -1, mTiles.GetHeight() - 1);
 }
\ No newline at end of file
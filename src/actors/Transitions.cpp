@@ -20,6 +20,9 @@ SceneTransition::SceneTransition(std::string newScene, float startTime, float pa
 
     mState = (!NearZero(mStartTime)) ? 0 : (!NearZero(mPauseTime)) ? 1
                                                                    : 2;
+
+    // Load the next scene's sprites while the transition plays out
+    Game::Get()->PrefetchScene(mNewScene);
 }
 SceneTransition::~SceneTransition()
 {
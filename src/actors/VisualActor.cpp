@@ -15,9 +15,11 @@ void VisualActor::Animation::Update(std::string name, float dt, std::string &nex
     if (sprite.expired())
         return;
 
-    auto &list = sprite.lock()->GetAnimation(sprAnimName);
-    if (!list.size())
+    // The sprite is shared between actors, so look the animation up without adding it
+    const std::vector<int> *anim = sprite.lock()->FindAnimation(sprAnimName);
+    if (!anim || !anim->size())
         return;
+    const std::vector<int> &list = *anim;
 
     frame += fps * dt;
     if (!loop)
@@ -70,6 +72,7 @@ void VisualActor::SetSprite(std::string imagePath)
     if (imagePath == "")
     {
         mSpritePath = "";
+        mSpriteHandle = SpriteHandle();
         return;
     }
 
@@ -79,6 +82,7 @@ void VisualActor::SetSprite(std::string imagePath)
     Game *game = Game::Get();
     if (game)
         mSpritePath = game->GetAssetPaths().sprites + imagePath;
+    mSpriteHandle = LoadSpriteHandle(mSpritePath);
 
     Sprite *sprite = GetRawSprite();
     if (!sprite)
@@ -88,14 +92,20 @@ void VisualActor::SetSprite(std::string imagePath)
 
 Sprite *VisualActor::GetSprite()
 {
-    std::shared_ptr<Sprite> sprite = LoadSprite(mSpritePath);
-    if (!sprite || !sprite.get())
+    Sprite *sprite = GetRawSprite();
+    if (!sprite)
         return &__tempSprite__;
-    return sprite.get();
+    return sprite;
 }
 Sprite *VisualActor::GetRawSprite()
 {
-    return LoadSprite(mSpritePath).get();
+    Game *game = Game::Get();
+    if (!game)
+        return nullptr;
+    // Only fall back to the path if the sprite was removed from the cache since it was set
+    if (!game->IsSpriteHandleValid(mSpriteHandle) && mSpritePath != "")
+        mSpriteHandle = LoadSpriteHandle(mSpritePath);
+    return game->GetSprite(mSpriteHandle);
 }
 
 std::string VisualActor::GetSpriteName()
@@ -145,6 +155,13 @@ Vec2<float> VisualActor::GetPrevPosition() const
 {
     return mPrevPosition;
 }
+Vec2<float> VisualActor::GetInterpolatedPosition() const
+{
+    Game *game = Game::Get();
+    if (!game || !game->GetOptions().fixedTimestep)
+        return mPosition;
+    return Vec2<float>::Lerp(mPrevPosition, mPosition, game->GetInterpolationAlpha());
+}
 
 void VisualActor::ClampPosition(const Vec2<float> &min, const Vec2<float> &max)
 {
@@ -259,11 +276,17 @@ void VisualActor::InternalFirstUpdate(float dt)
     mPrevPosition = mPosition;
 }
 
-void VisualActor::InternalUpdate(float dt)
+void VisualActor::InternalPreUpdate(float dt)
+{
+    mPrevPosition = mPosition;
+}
+
+void VisualActor::InternalParallelUpdate(float dt)
 {
     // Make sure that this actor has an actual sprite
-    Sprite *sprite = GetRawSprite();
-    if (!sprite)
+    // Only the cache is read here, since reloading a sprite isn't thread-safe
+    Game *game = Game::Get();
+    if (!game || !game->GetSprite(mSpriteHandle))
         return;
 
     for (auto &pair : mFrameAnimations)
@@ -273,7 +296,13 @@ void VisualActor::InternalUpdate(float dt)
     }
 }
 
+void VisualActor::InternalUpdate(float dt)
+{
+    // Reload the sprite if it was removed from the cache
+    GetRawSprite();
+}
+
 void VisualActor::Draw()
 {
-    DrawSprite(mSpritePath, GetFrame(), mPosition, {mScale, mRotation, mColor, mRoundToCamera});
+    DrawSprite(mSpriteHandle, GetFrame(), GetInterpolatedPosition(), {mScale, mRotation, mColor, mRoundToCamera});
 }
\ No newline at end of file
@@ -4,7 +4,7 @@
 
 using namespace junebug;
 
-Collider::Collider(VisualActor *owner, std::string layer) : Component(owner), mLayer(layer)
+Collider::Collider(VisualActor *owner, std::string layer) : Component(owner), mOwner(owner), mLayer(layer)
 {
 }
 
@@ -15,10 +15,13 @@ Collider::~Collider()
 
 void Collider::SetCollLayer(std::string layer)
 {
-    bool shouldUpdate = mLayer != layer;
+    if (mLayer == layer)
+        return;
+
+    // Remove from the old layer before switching
+    Game::Get()->RemoveCollision(this);
     mLayer = layer;
-    if (shouldUpdate)
-        UpdateCollEntry(false);
+    Game::Get()->AddCollision(this);
 }
 
 void Collider::SetType(CollType type)
@@ -9,9 +9,19 @@ using namespace junebug;
 
 void PolygonCollisionBounds::LoadVertices(const VerticesPtr vertices)
 {
+    if (this->vertices != vertices)
+        dirty = true;
     this->vertices = vertices;
 }
 
+bool PolygonCollisionBounds::BoundsOverlap(const PolygonCollisionBounds &other, Vec2<float> offset, Vec2<float> otherOffset) const
+{
+    return topLeft.x + offset.x < other.bottomRight.x + otherOffset.x &&
+           other.topLeft.x + otherOffset.x < bottomRight.x + offset.x &&
+           topLeft.y + offset.y < other.bottomRight.y + otherOffset.y &&
+           other.topLeft.y + otherOffset.y < bottomRight.y + offset.y;
+}
+
 bool PolygonCollisionBounds::CheckAxes(const PolygonCollisionBounds &other, float &overlap, Vec2<float> &minAxis, Vec2<float> offset, Vec2<float> otherOffset)
 {
     for (int i = 0; i < worldVertices.size(); i++)
@@ -49,47 +59,64 @@ Vec2<float> PolygonCollisionBounds::Project(Vec2<float> &axis, Vec2<float> &offs
     return Vec2(min, max);
 }
 
-void PolygonCollisionBounds::UpdateWorldVertices(const Vec2<float> &pos, float rot, const Vec2<float> &_scale, const Vec2<int> &_origin)
+void PolygonCollisionBounds::UpdateWorldVertices(const Vec2<float> &pos, float rot, const Vec2<float> &scale, const Vec2<int> &origin)
 {
     if (!vertices)
         return;
 
-    Vec2<float> origin = Vec2<float>(_origin), scale = Vec2<float>(_scale);
-    worldVertices.clear();
-    topLeft.x = topLeft.y = std::numeric_limits<float>::max();
-    bottomRight.x = bottomRight.y = std::numeric_limits<float>::min();
-
-    float ang = ToRadians(rot);
-    for (int i = 0; i < vertices->size(); i++)
+    size_t count = vertices->size();
+    if (dirty || localVertices.size() != count || rot != cachedRot || scale != cachedScale || origin != cachedOrigin)
     {
-        Vec2<float> v = vertices->at(i);
-        Vec2<float> newV(
-            origin.x + (cos(ang) * (v.x - origin.x) * scale.x + sin(ang) * (v.y - origin.y) * scale.y),
-            origin.y + (-sin(ang) * (v.x - origin.x) * scale.x + cos(ang) * (v.y - origin.y) * scale.y));
-        newV = ((newV - origin)) + Vec2<float>(pos);
-
-        if (newV.x < topLeft.x)
-            topLeft.x = (float)newV.x;
-        if (newV.y < topLeft.y)
-            topLeft.y = (float)newV.y;
-        if (newV.x > bottomRight.x)
-            bottomRight.x = (float)newV.x;
-        if (newV.y > bottomRight.y)
-            bottomRight.y = (float)newV.y;
-
-        worldVertices.push_back(newV);
-    }
+        // Resizing keeps the existing capacity, so this only allocates the first time
+        localVertices.resize(count);
+        axes.resize(count);
 
-    axes.clear();
-    for (int i = 0; i < worldVertices.size(); i++)
-    {
-        Vec2<float> v1 = worldVertices[i];
-        Vec2<float> v2 = worldVertices[(i + 1) % worldVertices.size()];
-        Vec2<float> edge = v1 - v2;
-        Vec2<float> perp = Vec2<float>(-edge.y, edge.x);
-        perp.Normalize();
-        axes.push_back(perp);
+        Vec2<float> orig = Vec2<float>(origin);
+        float ang = ToRadians(rot);
+        float c = Cos(ang), s = Sin(ang);
+
+        localTopLeft.x = localTopLeft.y = std::numeric_limits<float>::max();
+        localBottomRight.x = localBottomRight.y = std::numeric_limits<float>::lowest();
+        for (size_t i = 0; i < count; i++)
+        {
+            Vec2<float> d = ((*vertices)[i] - orig) * scale;
+            Vec2<float> v(c * d.x + s * d.y, -s * d.x + c * d.y);
+
+            if (v.x < localTopLeft.x)
+                localTopLeft.x = v.x;
+            if (v.y < localTopLeft.y)
+                localTopLeft.y = v.y;
+            if (v.x > localBottomRight.x)
+                localBottomRight.x = v.x;
+            if (v.y > localBottomRight.y)
+                localBottomRight.y = v.y;
+
+            localVertices[i] = v;
+        }
+
+        // Edge normals don't change with translation, so they only need rebuilding here
+        for (size_t i = 0; i < count; i++)
+        {
+            Vec2<float> edge = localVertices[i] - localVertices[(i + 1) % count];
+            Vec2<float> perp = Vec2<float>(-edge.y, edge.x);
+            perp.Normalize();
+            axes[i] = perp;
+        }
+
+        cachedRot = rot;
+        cachedScale = scale;
+        cachedOrigin = origin;
+        dirty = false;
     }
+    else if (pos == cachedPos && worldVertices.size() == count)
+        return;
+
+    worldVertices.resize(count);
+    for (size_t i = 0; i < count; i++)
+        worldVertices[i] = localVertices[i] + pos;
+    topLeft = localTopLeft + pos;
+    bottomRight = localBottomRight + pos;
+    cachedPos = pos;
 }
 
 PolygonCollider::PolygonCollider(VisualActor *owner, std::string layer) : Collider(owner, layer)
@@ -98,12 +125,22 @@ PolygonCollider::PolygonCollider(VisualActor *owner, std::string layer) : Collid
     UpdateCollEntry(true);
 }
 
+void PolygonCollider::PrepareUpdate(float dt)
+{
+    // Sprite changes are left to Update(), since loading vertices isn't thread-safe
+    // Update() rebuilds the vertices again, but with the same transform that only costs a comparison
+    SpriteHandle handle = mOwner->GetSpriteHandle();
+    Sprite *sprite = Game::Get()->GetSprite(handle);
+    if (sprite && handle == mParentSprite)
+        mCollBounds.UpdateWorldVertices(mOwner->GetPosition(), mOwner->GetRotation(), mOwner->GetScale(), sprite->GetOrigin());
+}
+
 void PolygonCollider::Update(float dt)
 {
-    if (mParentSprite != mOwner->GetSpriteName())
+    if (mParentSprite != mOwner->GetSpriteHandle())
     {
         Sprite *sprite = mOwner->GetSprite();
-        mParentSprite = mOwner->GetSpriteName();
+        mParentSprite = mOwner->GetSpriteHandle();
         if (sprite)
             mCollBounds.LoadVertices(sprite->GetVertices());
     }
@@ -124,6 +161,9 @@ CollSide PolygonCollider::Intersects(Collider *_other, Vec2<float> &offset)
     if (_other->GetType() == CollType::Polygon)
     {
         PolygonCollider *other = static_cast<PolygonCollider *>(_other);
+        if (!mCollBounds.BoundsOverlap(other->mCollBounds))
+            return CollSide::None;
+
         float overlap = FLT_MAX;
         Vec2<float> minAxis = Vec2<float>::Zero;
 
@@ -151,6 +191,17 @@ CollSide PolygonCollider::Intersects(Collider *_other, Vec2<float> &offset)
 void PolygonCollider::UpdateCollPositions(Vec2<float> offset)
 {
     mCollBounds.UpdateWorldVertices(mOwner->GetPosition() + offset, mOwner->GetRotation(), mOwner->GetScale(), mOwner->GetSprite()->GetOrigin());
+    Game::Get()->UpdateCollision(this);
+}
+
+bool PolygonCollider::GetBounds(Vec2<float> &topLeft, Vec2<float> &bottomRight) const
+{
+    if (mCollBounds.worldVertices.empty())
+        return false;
+
+    topLeft = mCollBounds.topLeft;
+    bottomRight = mCollBounds.bottomRight;
+    return true;
 }
 
 void PolygonCollider::Draw()
@@ -47,7 +47,7 @@ void Rigidbody::CheckCollisions()
     {
         for (auto &layer : Game::Get()->GetCollLayers())
         {
-            CheckCollisionList(layer.second);
+            CheckCollisionLayer(layer.first, layer.second);
         }
     }
     else
@@ -57,12 +57,26 @@ void Rigidbody::CheckCollisions()
             auto loc = Game::Get()->GetCollLayers().find(layer);
             if (loc != Game::Get()->GetCollLayers().end())
             {
-                CheckCollisionList(loc->second);
+                CheckCollisionLayer(loc->first, loc->second);
             }
         }
     }
 }
 
+void Rigidbody::CheckCollisionLayer(const std::string &layer, const std::vector<Collider *> &collisions)
+{
+    // Colliders without finite bounds have to be checked against the whole layer
+    Vec2<float> topLeft, bottomRight;
+    if (!mColl->GetBounds(topLeft, bottomRight))
+    {
+        CheckCollisionList(collisions);
+        return;
+    }
+
+    Game::Get()->QueryCollisions(layer, topLeft, bottomRight, mCandidates);
+    CheckCollisionList(mCandidates);
+}
+
 void Rigidbody::CheckCollisionList(const std::vector<Collider *> &collisions)
 {
     Vec2<float> fixVec = Vec2<float>::Zero;
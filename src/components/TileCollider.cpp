@@ -46,34 +46,34 @@ CollSide TileCollider::Intersects(Collider *_other, Vec2<float> &offset)
     if (_other->GetType() == CollType::Polygon)
     {
         PolygonCollider *other = static_cast<PolygonCollider *>(_other);
-        auto otherBounds = other->GetCollBounds();
+        // The other collider's bounds are refreshed with the accumulated offset below, so start from its current box
+        Vec2<float> otherTopLeft = other->mCollBounds.topLeft, otherBottomRight = other->mCollBounds.bottomRight;
         Vec2<int> min, max;
         Vec2<float> otherOffset = Vec2<float>::Zero;
         Vec2<float> oppositeDir = Vec2<float>(_other->mOwner->GetPosition() - _other->mOwner->GetPrevPosition());
         oppositeDir.Normalize();
 
-        auto &squareColliders = mOwner->GetSquareColliders();
+        const TileGrid &tiles = mOwner->GetTiles();
 
         std::map<Vec2<float>, std::pair<float, float>> axisCount;
         for (int i = 0; i < 8; i++)
         {
             axisCount.clear();
-            mOwner->GetCullBounds(otherBounds.topLeft + otherOffset, otherBounds.bottomRight + otherOffset, min, max);
+            mOwner->GetCullBounds(otherTopLeft + otherOffset, otherBottomRight + otherOffset, min, max);
 
             bool collided = false;
             for (Vec2<int> tile = min; tile.y <= max.y; tile.y++)
             {
                 for (tile.x = min.x; tile.x <= max.x; tile.x++)
                 {
-                    int tileIndex = mOwner->GetTile(tile);
-                    if (tileIndex == -1)
+                    int tileIndex = tiles.Get(tile);
+                    if (tileIndex == -1 || tileIndex >= (int)mColliders.size())
                         continue;
 
-                    // if (tileIndex < squareColliders.size() && squareColliders[tileIndex])
-                    //     continue;
-
                     auto &collBounds = mColliders[tileIndex];
                     Vec2<float> tilePos = Vec2<float>(mOwner->TileToWorld(tile));
+                    if (!collBounds.BoundsOverlap(other->mCollBounds, tilePos))
+                        continue;
 
                     float overlap = FLT_MAX;
                     Vec2<float> minAxis = Vec2<float>::Zero;
@@ -156,6 +156,7 @@ void TileCollider::Draw()
     Vec2<int> min, max;
     mOwner->GetCullBounds(cam->GetPosition(), cam->GetBottomRight(), min, max);
     auto &squareColliders = mOwner->GetSquareColliders();
+    const TileGrid &tiles = mOwner->GetTiles();
 
     // Draw all colliders except for squares
     Vec2<float> pos;
@@ -163,7 +164,7 @@ void TileCollider::Draw()
     {
         for (tile.x = min.x; tile.x <= max.x; tile.x++)
         {
-            int tileIndex = mOwner->GetTile(tile);
+            int tileIndex = tiles.Get(tile);
             if (tileIndex == -1 || tileIndex >= mColliders.size() || !mColliders[tileIndex].vertices || (tileIndex < squareColliders.size() && squareColliders[tileIndex]))
                 continue;
 
@@ -172,63 +173,113 @@ void TileCollider::Draw()
     }
 
     // Draw merged colliders
-    for (auto &collider : mMergedColliders)
+    Vec2<float> tileSize = Vec2<float>(mOwner->GetTileSize() * mOwner->GetScale());
+    mDrawVertices.resize(4);
+    for (auto &band : mMergedBands)
     {
-        DrawPolygonOutline(*collider.vertices, Color::Green);
+        for (auto &rect : band)
+        {
+            Vec2<float> size = Vec2<float>(rect.size) * tileSize;
+            mDrawVertices[0] = Vertex(0.0f, 0.0f);
+            mDrawVertices[1] = Vertex(size.x, 0.0f);
+            mDrawVertices[2] = size;
+            mDrawVertices[3] = Vertex(0.0f, size.y);
+            DrawPolygonOutline(mDrawVertices, Color::Green, mOwner->TileToWorld(rect.pos));
+        }
     }
 }
 
-void TileCollider::UpdateMergedColliders()
+void TileCollider::MarkTileDirty(Vec2<int> tile)
 {
-    const auto &tiles = mOwner->GetTiles();
-    const auto &squareColliders = mOwner->GetSquareColliders();
-    Vec2<float> ownerSize = Vec2<float>(mOwner->GetTileSize() * mOwner->GetScale());
+    int band = tile.y / kBandHeight;
+    if (tile.y < 0 || band >= (int)mDirtyBands.size())
+    {
+        // Outside of the current bands, so the grid must have grown
+        MarkAllDirty();
+        return;
+    }
 
-    mMergedColliders.clear();
-    mMergedColliderVertices.clear();
+    mDirtyBands[band] = true;
+    mAnyBandDirty = true;
+}
 
-    std::vector<std::vector<bool>> visited(tiles.size());
-    for (size_t i = 0; i < visited.size(); i++)
+void TileCollider::MarkAllDirty()
+{
+    mMergedGridSize = Vec2<int>(-1, -1);
+    mAnyBandDirty = true;
+}
+
+void TileCollider::UpdateMergedColliders()
+{
+    if (!mAnyBandDirty && mMergedGridSize == mOwner->GetTiles().GetSize())
+        return;
+
+    const TileGrid &tiles = mOwner->GetTiles();
+    if (mMergedGridSize != tiles.GetSize())
     {
-        visited[i].resize(tiles[i].size());
-        visited[i].assign(tiles[i].size(), false);
+        mMergedGridSize = tiles.GetSize();
+        int bands = (mMergedGridSize.y + kBandHeight - 1) / kBandHeight;
+        mMergedBands.resize(bands);
+        mDirtyBands.assign(bands, true);
     }
 
-    for (Vec2<int> tile = Vec2<int>::Zero; tile.y < tiles.size(); tile.y++)
+    for (size_t i = 0; i < mDirtyBands.size(); i++)
     {
-        for (tile.x = 0; tile.x < tiles[tile.y].size(); tile.x++)
+        if (mDirtyBands[i])
         {
-            if (visited[tile.y][tile.x])
-                continue;
-            visited[tile.y][tile.x] = true;
+            RebuildBand((int)i);
+            mDirtyBands[i] = false;
+        }
+    }
+    mAnyBandDirty = false;
+}
 
-            int tileIndex = mOwner->GetTile(tile);
-            if (tileIndex == -1 || tileIndex >= squareColliders.size() || !squareColliders[tileIndex])
+void TileCollider::RebuildBand(int band)
+{
+    const TileGrid &tiles = mOwner->GetTiles();
+    const auto &squareColliders = mOwner->GetSquareColliders();
+    auto isSquare = [&](int x, int y)
+    {
+        int tileIndex = tiles.Get(x, y);
+        return tileIndex != -1 && tileIndex < (int)squareColliders.size() && squareColliders[tileIndex];
+    };
+
+    int width = tiles.GetWidth();
+    int startY = band * kBandHeight, endY = Min(startY + kBandHeight, tiles.GetHeight());
+    auto &rects = mMergedBands[band];
+    rects.clear();
+    mVisited.assign((size_t)width * kBandHeight, false);
+    auto visited = [&](int x, int y)
+    {
+        return mVisited[(size_t)(y - startY) * width + x];
+    };
+
+    // Greedily grow each unvisited square tile right as far as possible, then down while the whole span is solid
+    for (int y = startY; y < endY; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            if (visited(x, y) || !isSquare(x, y))
                 continue;
 
-            int count = 1;
-            Vec2<float> offset = Vec2<float>(tile) * ownerSize;
+            int w = 1;
+            while (x + w < width && !visited(x + w, y) && isSquare(x + w, y))
+                w++;
 
-            // Check if the adjacent x tiles are also squares
-            int xTileIndex = mOwner->GetTile(tile + Vec2<int>(1, 0));
-            if (xTileIndex != -1 && xTileIndex < squareColliders.size() && squareColliders[xTileIndex])
+            int h = 1;
+            while (y + h < endY)
             {
-                while (xTileIndex != -1 && xTileIndex < squareColliders.size() && squareColliders[xTileIndex])
-                {
-                    visited[tile.y][tile.x + count] = true;
-                    count++;
-                    xTileIndex = mOwner->GetTile(tile + Vec2<int>(count, 0));
-                }
-
-                VerticesPtr vertices = std::make_shared<Vertices>(Vertices{offset, offset + Vertex(count * ownerSize.x, 0), offset + Vertex(count * ownerSize.x, ownerSize.y), offset + Vertex(0, ownerSize.y)});
-
-                PolygonCollisionBounds bounds;
-                mMergedColliders.push_back(bounds);
-                mMergedColliderVertices.push_back(vertices);
-                mMergedColliders.back().LoadVertices(mMergedColliderVertices.back());
-
-                continue;
+                bool solid = true;
+                for (int i = 0; i < w && solid; i++)
+                    solid = !visited(x + i, y + h) && isSquare(x + i, y + h);
+                if (!solid)
+                    break;
+                h++;
             }
+
+            for (int j = 0; j < h; j++)
+                std::fill_n(mVisited.begin() + (size_t)(y + j - startY) * width + x, w, true);
+            rects.push_back({Vec2<int>(x, y), Vec2<int>(w, h)});
         }
     }
 }
\ No newline at end of file
@@ -99,6 +99,8 @@ void Game::ProcessOptions(GameOptions newOptions, bool force)
     }
 
     // Optional window input mappings
+    mQuitAction = RegisterAction(JB_INPUT_QUIT);
+    mFullscreenAction = RegisterAction(JB_INPUT_FULLSCREEN);
 #ifndef __EMSCRIPTEN__
     if (options.quitOnEscape && !InputExists(JB_INPUT_QUIT, KEY_ESCAPE))
         SetInputMapping(JB_INPUT_QUIT, {KEY_ESCAPE});
@@ -113,7 +115,7 @@ void Game::ProcessOptions(GameOptions newOptions, bool force)
     if (!InputExists(JB_INPUT_RIGHT_CLICK, MOUSE_RIGHT))
         SetInputMapping(JB_INPUT_RIGHT_CLICK, {MOUSE_RIGHT});
 
-    if (options.detectFps && (force || prevOptions.detectFps != options.detectFps || prevOptions.fpsTarget != options.fpsTarget))
+    if (options.detectFps && mWindow && (force || prevOptions.detectFps != options.detectFps || prevOptions.fpsTarget != options.fpsTarget))
     {
         int displayIndex = SDL_GetWindowDisplayIndex(mWindow);
         SDL_DisplayMode displayMode;
@@ -124,19 +126,32 @@ void Game::ProcessOptions(GameOptions newOptions, bool force)
             Log("Targeting display refresh rate of " + std::to_string(displayMode.refresh_rate) + " fps");
         }
     }
-    mInvTargetFps = round<system_clock::duration>(dsec{1. / options.fpsTarget});
-    mSleepMargin = round<system_clock::duration>(dsec{options.sleepMargin / 1000.});
-
-    if (options.randomSeed > -1)
+    mFramePacer.SetTargetFps(options.fpsTarget);
+    mFramePacer.SetSleepEnabled(options.shouldThreadSleep);
+    // Don't throw away the measured oversleep unless the option itself changed
+    if (force || prevOptions.sleepMargin != options.sleepMargin)
+        mFramePacer.SetOversleepEstimate(options.sleepMargin);
+
+    Profiler &profiler = Profiler::Get();
+    profiler.SetEnabled(isDebug || options.profiler);
+    if (profiler.GetWindowSize() != options.profilerWindow)
+        profiler.SetWindowSize(options.profilerWindow);
+
+    // -2 means the seed has already been applied
+    if (options.randomSeed >= -1)
     {
-        if (options.randomSeed == -1)
-            srand((unsigned int)time(NULL));
-        else
-            srand((unsigned int)options.randomSeed);
+        SeedRandom(options.randomSeed == -1 ? (unsigned int)time(NULL) : (unsigned int)options.randomSeed);
         options.randomSeed = -2;
     }
 
-    SDL_ShowCursor(options.showCursor);
+    if (mWindow)
+        SDL_ShowCursor(options.showCursor);
+
+    if (force || prevOptions.collisionCellSize != options.collisionCellSize)
+    {
+        for (auto &grid : mCollGrids)
+            grid.second.SetCellSize(options.collisionCellSize);
+    }
 
     if (options.windowIcon != "" && mWindow && (force || prevOptions.windowIcon != options.windowIcon))
     {
@@ -176,11 +191,54 @@ void Game::Shutdown()
         mFonts.erase(mFonts.begin());
     }
 
-    SDL_DestroyWindow(mWindow);
+    mAssetLoader.Stop();
+    mJobs.Stop();
+    StopRecording();
+    StopReplay();
+    StopGamepads();
+
+    if (options.atlasCachePath != "" && mAtlas.IsDirty())
+        mAtlas.SaveCache(options.atlasCachePath);
+    mAtlas.Clear();
+
+    if (mWindow)
+        SDL_DestroyWindow(mWindow);
+    mWindow = nullptr;
+    mRenderer = nullptr;
     SDL_Quit();
 }
 
 bool Game::Run(int screenWidth, int screenHeight)
+{
+    if (!Init(screenWidth, screenHeight))
+        return false;
+
+#ifdef __EMSCRIPTEN__
+    emscripten_set_main_loop_arg(EmMainLoop, this, 0, 1);
+#else
+    while (mGameIsRunning)
+    {
+        if (!_GameLoopIteration())
+            break;
+    }
+#endif
+
+    Shutdown();
+
+    return true;
+}
+
+bool Game::Step(unsigned int frames)
+{
+    for (unsigned int i = 0; i < frames && mGameIsRunning; i++)
+    {
+        if (!_GameLoopIteration())
+            mGameIsRunning = false;
+    }
+    return mGameIsRunning;
+}
+
+bool Game::Init(int screenWidth, int screenHeight)
 {
     if (screenWidth < 0)
         screenWidth = options.defaultCameraSize.x;
@@ -198,6 +256,14 @@ bool Game::Run(int screenWidth, int screenHeight)
     putenv((char *)"SDL_HINT_RENDER_SCALE_QUALITY=1");
 #endif
 
+    if (options.headless)
+    {
+        // Events are still needed for SDL_PollEvent and the keyboard state
+        if (SDL_Init(SDL_INIT_EVENTS | SDL_INIT_TIMER) != 0)
+            return false;
+        return InitGame();
+    }
+
     if (SDL_Init(options.initFlags) != 0)
         return false;
 
@@ -228,8 +294,26 @@ bool Game::Run(int screenWidth, int screenHeight)
 
     SDL_SetRenderDrawBlendMode(mRenderer, SDL_BlendMode::SDL_BLENDMODE_BLEND);
 
+    if (options.textureAtlas)
+    {
+        mAtlas.Init(mRenderer, options.atlasPageSize, options.atlasCachePath != "");
+        if (options.atlasCachePath != "")
+            mAtlas.LoadCache(options.atlasCachePath);
+    }
+
     Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048);
 
+    return InitGame();
+}
+
+bool Game::InitGame()
+{
+    mAssetLoader.Start(options.assetLoaderThreads);
+    int workers = options.workerThreads;
+    if (workers < 0)
+        workers = Max((int)std::thread::hardware_concurrency() - 1, 0);
+    mJobs.Start(workers);
+
     if (mOptionsUpdated)
     {
         ProcessOptions(options, mOptionsUpdated);
@@ -238,6 +322,14 @@ bool Game::Run(int screenWidth, int screenHeight)
 
     JB_REGISTER_ACTORS(VisualActor, PhysicalActor, Background, Tileset);
 
+    StartGamepads();
+
+    // Recordings reseed the random generators, so they have to start before anything random happens
+    if (options.replayInputPath != "")
+        StartReplay(options.replayInputPath);
+    else if (options.recordInputPath != "")
+        StartRecording(options.recordInputPath);
+
     LoadData();
 
     if (options.startingScene != "")
@@ -250,21 +342,8 @@ bool Game::Run(int screenWidth, int screenHeight)
     // Process any options that were changed in LoadData()
     ProcessOptions(options, mOptionsUpdated);
 
-    mBeginFrame = system_clock::now();
-    mEndFrame = mBeginFrame + mInvTargetFps;
-    DebugResetCheckpoints();
-
-#ifdef __EMSCRIPTEN__
-    emscripten_set_main_loop_arg(EmMainLoop, this, 0, 1);
-#else
-    while (mGameIsRunning)
-    {
-        if (!_GameLoopIteration())
-            break;
-    }
-#endif
-
-    Shutdown();
+    mFramePacer.Reset();
+    Profiler::Get().Reset();
 
     return true;
 }
@@ -274,29 +353,46 @@ bool Game::_GameLoopIteration()
     HaltFrame();
     mFrameCount++;
 
-    DebugCheckpoint("GameLoop", options.showDefaultDebugCheckpoints);
-
-    ProcessInput();
+    {
+        JB_PROFILE_ZONE_IF("GameLoop", options.showDefaultDebugCheckpoints);
 
-    if (mGameIsRunning)
-        UpdateGame();
-    else
-        return false;
+        // Upload sprites that finished loading in the background
+        {
+            JB_PROFILE_ZONE_IF("Asset Uploads", options.showDefaultDebugCheckpoints);
+            mAssetLoader.Pump(options.assetUploadBudget);
+        }
 
-    if (mGameIsRunning)
-        GenerateOutput();
-    else
-        return false;
+        // Replays are recorded per update, so they run one update per frame regardless of the timestep
+        if (options.fixedTimestep && !IsReplaying())
+            RunFixedUpdates();
+        else
+        {
+            mInterpolationAlpha = 1.0f;
+            ProcessInput();
+            if (mGameIsRunning)
+                UpdateGame();
+        }
+        if (!mGameIsRunning)
+            return false;
 
-    LoadQueuedScenes();
+        if (!options.headless)
+            GenerateOutput();
 
-    DebugCheckpointStop("GameLoop");
+        LoadQueuedScenes();
+    }
+    Profiler::Get().EndFrame();
 
-    if (mGameIsRunning && !mSkipDebugPrintThisFrame)
+    // Printing to the console is slow, so only refresh it every so often
+    if (mGameIsRunning && isDebug)
     {
-        DebugPrintInfo();
-        DebugPrintCheckpoints();
-        mDebugAlreadyCleared = false;
+        mDebugPrintTimer += mDeltaTime;
+        if (!mSkipDebugPrintThisFrame && mDebugPrintTimer >= options.debugPrintInterval)
+        {
+            mDebugPrintTimer = 0.0f;
+            DebugPrintInfo();
+            DebugPrintCheckpoints();
+            mDebugAlreadyCleared = false;
+        }
         mSkipDebugPrintThisFrame = false;
     }
 
@@ -312,39 +408,44 @@ bool Game::_GameLoopIteration()
 
 void Game::HaltFrame()
 {
-    // Calculate the FPS
-    auto time_in_seconds = time_point_cast<seconds>(system_clock::now());
-    ++mFramesThisSecond;
-    if (time_in_seconds > mPrevSecond)
-    {
-        mFramesThisSecond = 0;
-        mPrevSecond = time_in_seconds;
-    }
+    // Headless games run as fast as possible, but still advance by a whole frame each time
+    // Replays overwrite the delta time with the recorded one
+    if (options.headless || (IsReplaying() && options.replayFullSpeed))
+        mDeltaTime = 1.0f / Max(options.fpsTarget, 1);
+    else
+        mDeltaTime = mFramePacer.Wait();
+}
 
-    // Sleep the thread until slightly before the next frame
-    if (options.shouldThreadSleep)
-        std::this_thread::sleep_until(mEndFrame - mSleepMargin);
+void Game::RunFixedUpdates()
+{
+    float frameTime = mDeltaTime, step = GetFixedDeltaTime();
 
-    // Manually block the thread until the exact time of the next frame
-    auto mWorkTime = system_clock::now() - mBeginFrame;
-    do
+    // Cap the time before accumulating it, so a long stall can't queue more updates than allowed
+    mFixedAccumulator += Min(frameTime, step * Max(options.maxFixedSteps, 1));
+
+    mDeltaTime = step;
+    while (mFixedAccumulator >= step && mGameIsRunning)
     {
-        mEndFrame = system_clock::now();
-        mWorkTime = mEndFrame - mBeginFrame;
-    } while (mWorkTime < mInvTargetFps);
-    mDeltaTime = (float)duration_cast<dsec>(mEndFrame - mBeginFrame).count();
-    mBeginFrame = mEndFrame;
-    mEndFrame = mBeginFrame + mInvTargetFps;
+        mFixedAccumulator -= step;
+        ProcessInput();
+        if (mGameIsRunning)
+            UpdateGame();
+    }
+    mDeltaTime = frameTime;
+
+    mInterpolationAlpha = Clamp(mFixedAccumulator / step, 0.0f, 1.0f);
 }
 
 bool Game::CompareActors(Actor *a1, Actor *a2)
 {
-    return (a1->mDepth < a2->mDepth);
+    if (a1->mDepth != a2->mDepth)
+        return a1->mDepth < a2->mDepth;
+    return a1->mSpawnOrder < a2->mSpawnOrder;
 }
 
 void Game::UpdateGame()
 {
-    DebugCheckpoint("Updates", options.showDefaultDebugCheckpoints);
+    JB_PROFILE_ZONE_IF("Updates", options.showDefaultDebugCheckpoints);
 
     // User-defined callback
     UpdateStart(mDeltaTime);
@@ -353,42 +454,86 @@ void Game::UpdateGame()
     UpdateTwerps(mDeltaTime);
 
     // Update actors
-    auto tempActors = mActors;
-    for (Actor *actor : tempActors)
+    // Actors spawned during the loop are appended past the end and wait until the next frame
+    // Actors deleted during the loop leave a null gap, so the indices stay valid
+    // With component passes or worker threads, the actors' main updates wait until every pass and parallel update has run
+    mUpdatingActors = true;
+    bool splitUpdates = !mComponentPasses.empty() || mJobs.GetWorkerCount() > 0;
+    size_t numActors = mActors.size();
+    for (size_t i = 0; i < numActors; i++)
     {
+        Actor *actor = mActors[i];
+        if (!actor)
+            continue;
+
         if (actor->GetState() == ActorState::Started)
         {
             actor->SetState(ActorState::Active);
             actor->InternalFirstUpdate(mDeltaTime);
             actor->FirstUpdate(mDeltaTime);
+            if (!mActors[i])
+                continue;
         }
 
         if (actor->GetState() == ActorState::Active)
         {
+            actor->InternalPreUpdate(mDeltaTime);
             for (Component<> *comp : actor->mComponents)
-                comp->Update(mDeltaTime);
+            {
+                if (!comp->InComponentPass())
+                    comp->Update(mDeltaTime);
+            }
+            if (!mActors[i])
+                continue;
         }
 
-        if (actor->GetState() == ActorState::Active)
+        if (!splitUpdates && actor->GetState() == ActorState::Active)
         {
+            actor->InternalParallelUpdate(mDeltaTime);
             actor->InternalUpdate(mDeltaTime);
             actor->Update(mDeltaTime);
         }
     }
 
-    std::vector<Actor *> destroyActors;
-    for (Actor *actor : mActors)
+    if (splitUpdates)
     {
-        if (actor->GetState() == ActorState::Destroy)
-            destroyActors.push_back(actor);
+        // Passes created during the loop are queued, so the list can't shift under it, and wait until the next frame
+        mUpdatingComponentPasses = true;
+        for (size_t i = 0; i < mComponentPasses.size(); i++)
+            mComponentPasses[i]->Update(mDeltaTime);
+        mUpdatingComponentPasses = false;
+        for (auto &pass : mQueuedComponentPasses)
+            AddComponentPass(pass.release());
+        mQueuedComponentPasses.clear();
+
+        // Each actor's parallel update only touches that actor, so they're spread across the workers
+        mJobs.ParallelFor(numActors, 64, [this](size_t begin, size_t end)
+                          {
+                              for (size_t i = begin; i < end; i++)
+                              {
+                                  Actor *actor = mActors[i];
+                                  if (actor && actor->GetState() == ActorState::Active)
+                                      actor->InternalParallelUpdate(mDeltaTime);
+                              } });
+
+        for (size_t i = 0; i < numActors; i++)
+        {
+            Actor *actor = mActors[i];
+            if (actor && actor->GetState() == ActorState::Active)
+            {
+                actor->InternalUpdate(mDeltaTime);
+                actor->Update(mDeltaTime);
+            }
+        }
     }
+    mUpdatingActors = false;
 
     // Remove destroyed actors
-    for (Actor *actor : destroyActors)
-        delete actor;
+    DestroyQueuedActors();
 
-    // Sort the actors
-    std::sort(mActors.begin(), mActors.end(), CompareActors);
+    // Depths rarely change, so only sort when one has
+    if (mActorOrderDirty)
+        SortActors();
 
     // User-defined callback
     UpdateEnd(mDeltaTime);
@@ -399,13 +544,15 @@ void Game::UpdateGame()
         ProcessOptions(options);
         mOptionsUpdated = false;
     }
-
-    DebugCheckpointStop("Updates");
 }
 
 void Game::GenerateOutput()
 {
-    DebugCheckpoint("Renders", options.showDefaultDebugCheckpoints);
+    JB_PROFILE_ZONE_IF("Renders", options.showDefaultDebugCheckpoints);
+
+    // Actors may have been spawned or moved between layers since the last update
+    if (mActorOrderDirty)
+        SortActors();
 
     SDL_Rect windowR;
     windowR.x = 0;
@@ -454,9 +601,9 @@ void Game::GenerateOutput()
     // User-defined callback
     RenderEnd();
 
+    // Presenting can block on vsync, so it's timed separately from drawing
+    JB_PROFILE_ZONE_IF("Present", options.showDefaultDebugCheckpoints);
     SDL_RenderPresent(mRenderer);
-
-    DebugCheckpointStop("Renders");
 }
 
 Vec2<int> Game::GetMousePos()
@@ -482,34 +629,117 @@ Vec2<int> Game::GetMouseOffset()
 
 void Game::AddActor(Actor *actor)
 {
+    actor->mSpawnOrder = mNextSpawnOrder++;
+    if (!mActors.empty() && (!mActors.back() || CompareActors(actor, mActors.back())))
+        mActorOrderDirty = true;
+
     mActors.push_back(actor);
+    actor->mInActorList = true;
+    if (mActorGaps > 0)
+        mActorsViewDirty = true;
+    mActorRegistry.Add(actor);
 }
 
 void Game::RemoveActor(Actor *actor)
 {
-    // Remove from actor list
-    mActors.erase(std::remove(mActors.begin(), mActors.end(), actor), mActors.end());
+    if (!actor)
+        return;
+
+    // Remove from actor list, unless DestroyQueuedActors() already did
+    if (actor->mInActorList)
+    {
+        auto it = std::find(mActors.begin(), mActors.end(), actor);
+        if (it != mActors.end())
+        {
+            // Don't shift the list while it's being updated; the gap is closed once the update finishes
+            if (mUpdatingActors)
+            {
+                *it = nullptr;
+                mActorGaps++;
+                mActorsViewDirty = true;
+            }
+            else
+                mActors.erase(it);
+        }
+        actor->mInActorList = false;
+    }
+    mActorRegistry.Remove(actor);
 
     // Remove any active twerp coroutines
-    if (actor)
+    mTwerps.RemoveOwner(actor);
+}
+
+const std::vector<Actor *> &Game::GetAllActors() const
+{
+    if (mActorGaps == 0)
+        return mActors;
+
+    // The gaps are only closed once the update finishes, so until then a copy without them is handed out
+    if (mActorsViewDirty)
     {
-        mTwerpAsyncsFloat.erase(actor);
-        mTwerpAsyncsInt.erase(actor);
-        mTwerpAsyncsUint8.erase(actor);
+        mActorsView.clear();
+        for (Actor *actor : mActors)
+        {
+            if (actor)
+                mActorsView.push_back(actor);
+        }
+        mActorsViewDirty = false;
     }
+    return mActorsView;
 }
 
-template <typename T>
-T *Game::GetActor(std::string id)
+void Game::DestroyQueuedActors()
 {
-    for (auto actor : mActors)
+    // This also closes any gaps left by actors deleted during the update
+    size_t kept = 0;
+    for (Actor *actor : mActors)
     {
-        if (actor->GetId() == id)
+        if (!actor)
+            continue;
+        if (actor->GetState() == ActorState::Destroy)
         {
-            return dynamic_cast<T *>(actor);
+            actor->mInActorList = false;
+            mDestroyQueue.push_back(actor);
         }
+        else
+            mActors[kept++] = actor;
     }
-    return nullptr;
+    mActors.resize(kept);
+    mActorGaps = 0;
+    mActorsView.clear();
+    if (mDestroyQueue.empty())
+        return;
+
+    // Destructors may create or destroy other actors, so only the queue is walked here
+    for (size_t i = 0; i < mDestroyQueue.size(); i++)
+        delete mDestroyQueue[i];
+    mDestroyQueue.clear();
+}
+
+void Game::SortActors()
+{
+    // Compaction keeps the list's order, so removals never require a sort
+    std::stable_sort(mActors.begin(), mActors.end(), CompareActors);
+    mActorOrderDirty = false;
+}
+
+void Game::SetActorId(Actor *actor, const std::string &id)
+{
+    mActorRegistry.SetId(actor, id);
+}
+
+void Game::AddComponentPass(ComponentPass *pass)
+{
+    if (mUpdatingComponentPasses)
+    {
+        mQueuedComponentPasses.emplace_back(pass);
+        return;
+    }
+
+    auto it = std::upper_bound(mComponentPasses.begin(), mComponentPasses.end(), pass->GetUpdateOrder(),
+                               [](int order, const std::unique_ptr<ComponentPass> &other)
+                               { return order < other->GetUpdateOrder(); });
+    mComponentPasses.emplace(it, pass);
 }
 
 void Game::AddCamera(Camera *camera)
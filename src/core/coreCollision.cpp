@@ -5,7 +5,13 @@ using namespace junebug;
 
 void Game::AddCollision(Collider *coll)
 {
-    mCollLayers[coll->GetCollLayer()].push_back(coll);
+    const std::string &layer = coll->GetCollLayer();
+    mCollLayers[layer].push_back(coll);
+
+    auto grid = mCollGrids.find(layer);
+    if (grid == mCollGrids.end())
+        grid = mCollGrids.emplace(layer, SpatialHash(options.collisionCellSize)).first;
+    grid->second.Insert(coll);
 }
 
 void Game::RemoveCollision(Collider *coll)
@@ -14,9 +20,31 @@ void Game::RemoveCollision(Collider *coll)
     auto it = std::find(layer.begin(), layer.end(), coll);
     if (it != layer.end())
         layer.erase(it);
+
+    auto grid = mCollGrids.find(coll->GetCollLayer());
+    if (grid != mCollGrids.end())
+        grid->second.Remove(coll);
+}
+
+void Game::UpdateCollision(Collider *coll)
+{
+    auto grid = mCollGrids.find(coll->GetCollLayer());
+    if (grid != mCollGrids.end())
+        grid->second.Update(coll);
 }
 
 const Game::collision_layers &Game::GetCollLayers() const
 {
     return mCollLayers;
+}
+
+void Game::QueryCollisions(const std::string &layer, const Vec2<float> &topLeft, const Vec2<float> &bottomRight, std::vector<Collider *> &out)
+{
+    auto grid = mCollGrids.find(layer);
+    if (grid == mCollGrids.end())
+    {
+        out.clear();
+        return;
+    }
+    grid->second.Query(topLeft, bottomRight, out);
 }
\ No newline at end of file
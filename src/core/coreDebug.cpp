@@ -1,9 +1,6 @@
 #include "Game.h"
 
 #include <iostream>
-#include <map>
-#include <mutex>
-#include <ctime>
 
 using namespace junebug;
 
@@ -12,7 +9,8 @@ void Game::DebugFormatConsole(std::string header)
     if (!mDebugAlreadyCleared)
     {
 #ifdef linux
-        system("clear");
+        // Clear the terminal and move to the top with escape codes, rather than starting a whole process to do it
+        std::cout << "\033[2J\033[H";
 #elif __EMSCRIPTEN__
         EM_ASM(console.clear());
 #endif
@@ -28,86 +26,44 @@ void Game::DebugFormatConsole(std::string header)
 
 void Game::DebugCheckpoint(std::string name, bool condition)
 {
-    if (!isDebug || !condition)
+    if (!condition)
         return;
 
-#ifndef __EMSCRIPTEN__
-    Game::Get()->mDebugCheckpoints.push_back({name, high_resolution_clock::now(), 0});
-#endif
+    Profiler &profiler = Profiler::Get();
+    if (profiler.IsEnabled())
+        profiler.BeginZone(Profiler::RegisterZone(name));
 }
 void Game::DebugCheckpointStop(std::string name)
 {
-    if (!isDebug)
-        return;
-
-#ifndef __EMSCRIPTEN__
-    Game::Get()->mDebugCheckpoints.push_back({name, high_resolution_clock::now(), 1});
-#endif
+    Profiler &profiler = Profiler::Get();
+    if (profiler.IsEnabled())
+        profiler.EndZone(Profiler::RegisterZone(name));
 }
 
 void Game::DebugPrintCheckpoints()
 {
-    if (!isDebug || mDebugCheckpoints.empty())
+    if (!isDebug)
+        return;
+
+    std::vector<ZoneStats> stats = Profiler::Get().GetStats();
+    if (stats.empty())
         return;
     mDebugSectionHeader = false;
 
-    std::vector<std::pair<std::string, time_point<system_clock, nanoseconds>>> stack;
-    std::map<std::string, std::string> messages;
-    std::string indent = DEBUG_INDENT;
-    for (auto &checkpoint : mDebugCheckpoints)
+    DebugFormatConsole("---Profiler (ms per frame)---");
+    for (auto &zone : stats)
     {
-        std::string name = std::get<0>(checkpoint);
-        auto time = std::get<1>(checkpoint);
-        int type = std::get<2>(checkpoint);
-
-        if (type == 0)
-        {
-            stack.push_back({name, time});
-            messages[name] = indent;
+        std::string indent = DEBUG_INDENT;
+        for (int i = 0; i < zone.depth; i++)
             indent += DEBUG_INDENT;
-        }
-        else if (type == 1)
-        {
-            indent = indent.substr(0, indent.size() - DEBUG_INDENT.size());
-
-            if (stack.empty())
-            {
-                continue;
-            }
 
-            auto &top = stack.back();
-            if (top.first != name)
-            {
-                continue;
-            }
-
-            float num = duration_cast<microseconds>(
-                            time - top.second)
-                            .count() /
-                        1000.0f;
-            messages[top.first] += name + " took " + RoundDecStr(num, 3) + " ms";
-            stack.pop_back();
-        }
+        std::string calls = zone.calls > 1.0f ? " (" + RoundDecStr(zone.calls, 1) + " calls)" : "";
+        PrintNoSpaces(indent, zone.name, calls, ": ",
+                      RoundDecStr(zone.avg, 3), " avg, ",
+                      RoundDecStr(zone.min, 3), " min, ",
+                      RoundDecStr(zone.max, 3), " max, ",
+                      RoundDecStr(zone.p99, 3), " p99");
     }
-
-    for (auto &pair : messages)
-    {
-        if (IsWhitespace(pair.second))
-            continue;
-        DebugFormatConsole("---Debug Checkpoints---");
-        print(pair.second);
-    }
-
-    DebugResetCheckpoints();
-}
-
-void Game::DebugResetCheckpoints()
-{
-    mDebugCheckpoints.clear();
-
-#ifndef __EMSCRIPTEN__
-    mDebugCheckpointStart = high_resolution_clock::now();
-#endif
 }
 
 void Game::DebugPrintInfo()
@@ -120,12 +76,14 @@ void Game::DebugPrintInfo()
         return;
     mDebugSectionHeader = false;
     DebugFormatConsole("---Debug Info---");
-    PrintNoSpaces(DEBUG_INDENT, mFps, " FPS");
+    const FrameStats &stats = mFramePacer.GetStats();
+    PrintNoSpaces(DEBUG_INDENT, stats.fps, " FPS");
     PrintNoSpaces(DEBUG_INDENT, "Delta Time: ", RoundDec(mDeltaTime * 1000.0f, 3), "ms");
+    PrintNoSpaces(DEBUG_INDENT, "Frame Time: ", RoundDec(stats.averageFrameTime * 1000.0f, 3), "ms avg, ", RoundDec(stats.minFrameTime * 1000.0f, 3), "ms min, ", RoundDec(stats.maxFrameTime * 1000.0f, 3), "ms max");
+    PrintNoSpaces(DEBUG_INDENT, "Work Time: ", RoundDec(stats.workTime * 1000.0f, 3), "ms");
     PrintNoSpaces(DEBUG_INDENT, "Actors: ", mActors.size());
 
-    int numCoroutines = CountTwerps(mTwerpAsyncsFloat) + CountTwerps(mTwerpAsyncsInt) + CountTwerps(mTwerpAsyncsUint8);
-    PrintNoSpaces(DEBUG_INDENT, "Coroutines: ", numCoroutines);
+    PrintNoSpaces(DEBUG_INDENT, "Coroutines: ", mTwerps.Count());
 
     PrintNoSpaces(DEBUG_INDENT, "Loaded Sprites: ", mSpriteCache.size());
 }
@@ -4,6 +4,10 @@ using namespace junebug;
 
 FC_Font *Game::AddFont(std::string file, int size, int style, Color color)
 {
+    // Fonts are cached on the renderer, so there's nothing to load in headless games
+    if (!mRenderer)
+        return nullptr;
+
     FC_Font *font = FC_CreateFont();
     FC_LoadFont(font, mRenderer, ("assets/fonts/" + file).c_str(), size, FC_MakeColor(255, 255, 255, 255), style);
 
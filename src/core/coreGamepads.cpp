@@ -0,0 +1,160 @@
+#include "Game.h"
+
+using namespace junebug;
+
+static_assert(kNumPadInputs == SDL_CONTROLLER_BUTTON_MAX + SDL_CONTROLLER_AXIS_MAX + 4, "Gamepad input codes don't match SDL's buttons and axes");
+
+// The input each axis drives
+// Sticks drive two inputs, the negative direction followed by the positive one
+static const int kAxisInputs[SDL_CONTROLLER_AXIS_MAX] = {
+    PAD_LEFT_STICK_LEFT, PAD_LEFT_STICK_UP, PAD_RIGHT_STICK_LEFT, PAD_RIGHT_STICK_UP, PAD_LEFT_TRIGGER, PAD_RIGHT_TRIGGER};
+
+static float ApplyDeadZone(float value, float deadZone)
+{
+    deadZone = Clamp(deadZone, 0.0f, 0.99f);
+    if (value <= deadZone)
+        return 0.0f;
+    return Min((value - deadZone) / (1.0f - deadZone), 1.0f);
+}
+
+void Game::StartGamepads()
+{
+    if (mGamepadsStarted || !options.gamepads)
+        return;
+
+    // Where SDL supports it, devices are read on their own thread so hot-plugging doesn't hold up a frame
+    SDL_SetHint(SDL_HINT_JOYSTICK_THREAD, "1");
+    if (SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER) != 0)
+    {
+        PrintLog("Failed to start gamepads:", SDL_GetError());
+        return;
+    }
+    mGamepadsStarted = true;
+}
+
+void Game::StopGamepads()
+{
+    if (!mGamepadsStarted)
+        return;
+
+    for (Gamepad &pad : mGamepads)
+    {
+        if (pad.controller)
+            SDL_GameControllerClose(pad.controller);
+    }
+    mGamepads.clear();
+    SDL_QuitSubSystem(SDL_INIT_GAMECONTROLLER);
+    mGamepadsStarted = false;
+}
+
+void Game::ProcessGamepadEvent(const SDL_Event &event)
+{
+    switch (event.type)
+    {
+    case SDL_CONTROLLERDEVICEADDED:
+    {
+        if (FindGamepadPlayer(SDL_JoystickGetDeviceInstanceID(event.cdevice.which)) >= 0)
+            break;
+
+        SDL_GameController *controller = SDL_GameControllerOpen(event.cdevice.which);
+        if (!controller)
+        {
+            PrintLog("Failed to open gamepad:", SDL_GetError());
+            break;
+        }
+
+        int player = 0;
+        while (player < (int)mGamepads.size() && mGamepads[player].controller)
+            player++;
+        Gamepad &pad = GetGamepadSlot(player);
+        pad.controller = controller;
+        pad.id = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(controller));
+        SDL_GameControllerSetPlayerIndex(controller, player);
+        break;
+    }
+    case SDL_CONTROLLERDEVICEREMOVED:
+    {
+        int player = FindGamepadPlayer(event.cdevice.which);
+        if (player < 0)
+            break;
+
+        Gamepad &pad = mGamepads[player];
+        SDL_GameControllerClose(pad.controller);
+        pad.controller = nullptr;
+        pad.id = -1;
+        // Anything held on an unplugged gamepad is let go
+        if (!IsReplaying())
+            ReleasePadInputs(player, event.cdevice.timestamp);
+        break;
+    }
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+    {
+        int player = FindGamepadPlayer(event.cbutton.which);
+        if (player < 0 || IsReplaying() || event.cbutton.button >= SDL_CONTROLLER_BUTTON_MAX)
+            break;
+        SetPadValue(player, event.cbutton.button, event.type == SDL_CONTROLLERBUTTONDOWN ? 1.0f : 0.0f, event.cbutton.timestamp);
+        break;
+    }
+    case SDL_CONTROLLERAXISMOTION:
+    {
+        int player = FindGamepadPlayer(event.caxis.which);
+        if (player < 0 || IsReplaying() || event.caxis.axis >= SDL_CONTROLLER_AXIS_MAX)
+            break;
+
+        float value = Clamp(event.caxis.value / 32767.0f, -1.0f, 1.0f);
+        int pad = kAxisInputs[event.caxis.axis] - PAD_A;
+        if (event.caxis.axis == SDL_CONTROLLER_AXIS_TRIGGERLEFT || event.caxis.axis == SDL_CONTROLLER_AXIS_TRIGGERRIGHT)
+            SetPadValue(player, pad, ApplyDeadZone(value, options.gamepadDeadZone), event.caxis.timestamp);
+        else
+        {
+            SetPadValue(player, pad, ApplyDeadZone(-value, options.gamepadDeadZone), event.caxis.timestamp);
+            SetPadValue(player, pad + 1, ApplyDeadZone(value, options.gamepadDeadZone), event.caxis.timestamp);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+int Game::FindGamepadPlayer(SDL_JoystickID id)
+{
+    if (id < 0)
+        return -1;
+    for (int player = 0; player < (int)mGamepads.size(); player++)
+    {
+        if (mGamepads[player].id == id)
+            return player;
+    }
+    return -1;
+}
+
+Game::Gamepad &Game::GetGamepadSlot(int player)
+{
+    if (player >= (int)mGamepads.size())
+        mGamepads.resize(player + 1);
+    return mGamepads[player];
+}
+
+void Game::SetPadValue(int player, int pad, float value, Uint32 timestamp)
+{
+    Gamepad &slot = GetGamepadSlot(player);
+    bool wasDown = slot.values[pad] > 0.0f, down = value > 0.0f;
+    slot.values[pad] = value;
+    if (down != wasDown)
+        QueueInputEvent(PAD_A + pad, down, timestamp, player);
+}
+
+void Game::ReleasePadInputs(int player, Uint32 timestamp)
+{
+    for (int pad = 0; pad < kNumPadInputs; pad++)
+        SetPadValue(player, pad, 0.0f, timestamp);
+}
+
+SDL_GameController *Game::GetGamepad(int player)
+{
+    if (player < 0 || player >= (int)mGamepads.size())
+        return nullptr;
+    return mGamepads[player].controller;
+}
\ No newline at end of file
@@ -5,19 +5,29 @@ using namespace junebug;
 
 void Game::ProcessInput()
 {
-    DebugCheckpoint("Inputs", options.showDefaultDebugCheckpoints);
+    JB_PROFILE_ZONE_IF("Inputs", options.showDefaultDebugCheckpoints);
 
     // Store the current screen size in case fullscreen is toggled
     Vec2<int> oldScreenSize(mScreenWidth, mScreenHeight), oldWindowPos;
-    SDL_GetWindowSize(mWindow, &mScreenWidth, &mScreenHeight);
+    if (mWindow)
+        SDL_GetWindowSize(mWindow, &mScreenWidth, &mScreenHeight);
 
     SDL_Event event = {0};
-    std::unordered_map<Uint8, std::pair<int, float>> newInputs;
 
     // Read keyboard state
     const Uint8 *state = SDL_GetKeyboardState(NULL);
 
+    mInputEvents.clear();
+    std::fill(std::begin(mInputPresses), std::end(mInputPresses), 0);
+    for (Gamepad &pad : mGamepads)
+        std::fill(std::begin(pad.presses), std::end(pad.presses), 0);
+
+    // Only the last mouse motion matters, so it's mapped to the screen once after polling
+    bool mouseMoved = false;
+    Vec2<int> mouseWindowPos;
+
     // Read poll events
+    // Replays supply their own presses and mouse position
     while (SDL_PollEvent(&event))
     {
         switch (event.type)
@@ -26,51 +36,32 @@ void Game::ProcessInput()
             if (options.autoCloseOnQuit)
                 mGameIsRunning = false;
             break;
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            // Scancodes past the standard keys share numbers with gamepad inputs
+            if (!IsReplaying() && !event.key.repeat && (int)event.key.keysym.scancode < PAD_A)
+                QueueInputEvent((InputCode)event.key.keysym.scancode, event.type == SDL_KEYDOWN, event.key.timestamp);
+            break;
         case SDL_MOUSEMOTION:
-        {
-            int w, h;
-            SDL_GetWindowSize(mWindow, &w, &h);
-            w = std::max(w, 1);
-            h = std::max(h, 1);
-            mMouseScreenPos.x = event.motion.x * mScreenWidth / w;
-            mMouseScreenPos.y = event.motion.y * mScreenHeight / h;
-            if (options.screenStretch)
-            {
-                mMouseScreenPos.x /= ((float)w / (float)mRenderWidth);
-                mMouseScreenPos.y /= ((float)h / (float)mRenderHeight);
-            }
-
-            // Get the mouse coordinates relative to a screen camera
-            mMouseCamera = nullptr;
-            float minDist = 10000000.0f;
-            for (Camera *cam : mCameras)
-            {
-                if (!cam->IsScreenCamera())
-                    continue;
-                float dist = (mMouseScreenPos - cam->GetScreenCenter()).Length();
-                if (dist < minDist)
-                {
-                    mMouseCamera = cam;
-                    minDist = dist;
-                }
-            }
-
-            mMousePos = mMouseScreenPos;
-            if (mMouseCamera)
-            {
-                mMousePos += Vec2(
-                    (int)(mMouseCamera->GetPosition().x - mMouseCamera->GetScreenPos().x),
-                    (int)(mMouseCamera->GetPosition().y - mMouseCamera->GetScreenPos().y));
-                mMouseOffset = mMousePos - mMouseCamera->GetPosition();
-            }
-
+            mouseMoved = true;
+            mouseWindowPos = Vec2<int>(event.motion.x, event.motion.y);
             break;
-        }
         case SDL_MOUSEBUTTONDOWN:
-            mExtraStates[event.button.button + MOUSE_LEFT - 1] = 1;
-            break;
         case SDL_MOUSEBUTTONUP:
-            mExtraStates[event.button.button + MOUSE_LEFT - 1] = 0;
+        {
+            InputCode input = event.button.button + MOUSE_LEFT - 1;
+            bool down = event.type == SDL_MOUSEBUTTONDOWN;
+            mExtraStates[input] = down;
+            if (!IsReplaying())
+                QueueInputEvent(input, down, event.button.timestamp);
+            break;
+        }
+        case SDL_CONTROLLERDEVICEADDED:
+        case SDL_CONTROLLERDEVICEREMOVED:
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+        case SDL_CONTROLLERAXISMOTION:
+            ProcessGamepadEvent(event);
             break;
         case SDL_WINDOWEVENT:
             if (event.window.event == SDL_WINDOWEVENT_CLOSE && event.window.windowID == SDL_GetWindowID(mWindow))
@@ -81,41 +72,117 @@ void Game::ProcessInput()
                 mScreenHeight = event.window.data2;
             }
             break;
+        case SDL_RENDER_TARGETS_RESET:
+        case SDL_RENDER_DEVICE_RESET:
+            mRenderTargetResets++;
+            mRenderQueue.OnRendererReset();
+            break;
         default:
             break;
         }
     }
 
-    // Loop through all inputs
-    for (auto &playerMapping : mInputMappings)
+    if (mouseMoved && !IsReplaying() && mWindow)
+    {
+        int w, h;
+        SDL_GetWindowSize(mWindow, &w, &h);
+        w = std::max(w, 1);
+        h = std::max(h, 1);
+        Vec2<int> screenPos(mouseWindowPos.x * mScreenWidth / w, mouseWindowPos.y * mScreenHeight / h);
+        if (options.screenStretch)
+        {
+            screenPos.x /= ((float)w / (float)mRenderWidth);
+            screenPos.y /= ((float)h / (float)mRenderHeight);
+        }
+        SetMouseScreenPos(screenPos);
+    }
+
+    // Replays replace the devices' state, and the frame's length, with the recording's
+    if (IsReplaying())
+        ReadReplayFrame();
+    else if (IsRecording())
+        WriteRecordingFrame(state);
+
+    // Update how long every input code has been held
+    for (int input = 0; input < kNumInputCodes; input++)
+    {
+        bool deviceDown = input < PAD_A && (IsReplaying() ? mReplayStates[input] : (state[input] || mExtraStates[input]));
+        if (mInputPresses[input])
+        {
+            // A press always starts a new hold, even if it was released again before this update
+            mInputFrames[input] = 1;
+            mInputTimes[input] = mDeltaTime;
+        }
+        else if (deviceDown || mScriptedStates[input])
+        {
+            mInputFrames[input]++;
+            mInputTimes[input] += mDeltaTime;
+        }
+        else
+        {
+            mInputFrames[input] = 0;
+            mInputTimes[input] = 0.0f;
+        }
+    }
+
+    // Each player's gamepad inputs are tracked the same way
+    for (Gamepad &pad : mGamepads)
     {
-        for (auto &[key, inputs] : playerMapping)
+        for (int i = 0; i < kNumPadInputs; i++)
         {
-            inputs.second.first = 0;
-            inputs.second.second = 0.0f;
-            for (auto input : inputs.first)
+            if (pad.presses[i])
             {
-                if (state[input] || mExtraStates[input])
+                pad.frames[i] = 1;
+                pad.times[i] = mDeltaTime;
+            }
+            else if (pad.values[i] > 0.0f)
+            {
+                pad.frames[i]++;
+                pad.times[i] += mDeltaTime;
+            }
+            else
+            {
+                pad.frames[i] = 0;
+                pad.times[i] = 0.0f;
+            }
+        }
+    }
+
+    // Each action takes the longest held of its inputs
+    for (int player = 0; player < (int)mActionStates.size(); player++)
+    {
+        Gamepad *pad = player < (int)mGamepads.size() ? &mGamepads[player] : nullptr;
+        for (ActionState &action : mActionStates[player])
+        {
+            bool wasHeld = action.frames > 0;
+            action.frames = 0;
+            action.time = 0.0f;
+            action.value = 0.0f;
+            for (InputCode input : action.inputs)
+            {
+                action.frames = std::max(action.frames, mInputFrames[input]);
+                action.time = std::max(action.time, mInputTimes[input]);
+                if (mInputFrames[input])
+                    action.value = 1.0f;
+                if (pad && IsPadInput(input))
                 {
-                    auto loc = mInputs.find(input);
-                    int frames = loc != mInputs.end() ? loc->second.first + 1 : 1;
-                    float val = loc != mInputs.end() ? loc->second.second + mDeltaTime : mDeltaTime;
-                    newInputs[input] = std::make_pair(frames, val);
-                    inputs.second.first = std::max(inputs.second.first, frames);
-                    inputs.second.second = std::max(inputs.second.second, val);
+                    int i = input - PAD_A;
+                    action.frames = std::max(action.frames, pad->frames[i]);
+                    action.time = std::max(action.time, pad->times[i]);
+                    action.value = std::max(action.value, pad->values[i]);
                 }
             }
+            action.released = wasHeld && action.frames == 0;
         }
     }
-    mInputs = newInputs;
 
     // Default Events
-    float quitTime = Input(JB_INPUT_QUIT, -1);
+    float quitTime = Input(mQuitAction, -1);
     if (!NearZero(quitTime) && quitTime > options.quitCloseTime)
     {
         mGameIsRunning = false;
     }
-    if (InputPressed(JB_INPUT_FULLSCREEN, -1))
+    if (mWindow && InputPressed(mFullscreenAction, -1))
     {
 #ifndef __EMSCRIPTEN__
         if (!mFullscreen)
@@ -169,113 +236,229 @@ void Game::ProcessInput()
     }
 
     // User-defined callback
-    InputsProcessed(state);
+    InputsProcessed(IsReplaying() ? mReplayStates : state);
+}
+
+void Game::SetMouseScreenPos(Vec2<int> screenPos)
+{
+    mMouseScreenPos = screenPos;
 
-    DebugCheckpointStop("Inputs");
+    // Get the mouse coordinates relative to a screen camera
+    mMouseCamera = nullptr;
+    float minDist = 10000000.0f;
+    for (Camera *cam : mCameras)
+    {
+        if (!cam->IsScreenCamera())
+            continue;
+        float dist = (mMouseScreenPos - cam->GetScreenCenter()).Length();
+        if (dist < minDist)
+        {
+            mMouseCamera = cam;
+            minDist = dist;
+        }
+    }
+
+    mMousePos = mMouseScreenPos;
+    if (mMouseCamera)
+    {
+        mMousePos += Vec2(
+            (int)(mMouseCamera->GetPosition().x - mMouseCamera->GetScreenPos().x),
+            (int)(mMouseCamera->GetPosition().y - mMouseCamera->GetScreenPos().y));
+        mMouseOffset = mMousePos - mMouseCamera->GetPosition();
+    }
 }
 
-float Game::Input(std::string key, int player)
+Game::ActionState *Game::GetActionState(ActionId action, int player)
+{
+    if (action < 0 || player < 0 || player >= (int)mActionStates.size() || action >= (int)mActionStates[player].size())
+        return nullptr;
+    return &mActionStates[player][action];
+}
+
+float Game::Input(ActionId action, int player)
 {
     if (player < 0)
     {
         float maxVal = 0;
-        for (int i = 0; i < mInputMappings.size(); i++)
-        {
-            maxVal = Max(maxVal, Input(key, i));
-        }
+        for (int i = 0; i < (int)mActionStates.size(); i++)
+            maxVal = Max(maxVal, Input(action, i));
         return maxVal;
     }
-    else
+
+    ActionState *state = GetActionState(action, player);
+    return state ? state->time : 0.0f;
+}
+float Game::Input(const std::string &key, int player)
+{
+    return Input(GetActionId(key), player);
+}
+
+bool Game::InputPressed(ActionId action, int player)
+{
+    if (player < 0)
     {
-        if (player >= mInputMappings.size())
-            return 0.0f;
-        auto it = mInputMappings[player].find(key);
-        if (it == mInputMappings[player].end())
-            return 0;
-        return it->second.second.second;
+        for (int i = 0; i < (int)mActionStates.size(); i++)
+        {
+            if (InputPressed(action, i))
+                return true;
+        }
+        return false;
     }
+
+    ActionState *state = GetActionState(action, player);
+    return state && state->frames == 1;
+}
+bool Game::InputPressed(const std::string &key, int player)
+{
+    return InputPressed(GetActionId(key), player);
 }
 
-bool Game::InputPressed(std::string key, int player)
+bool Game::InputReleased(ActionId action, int player)
 {
     if (player < 0)
     {
-        for (int i = 0; i < mInputMappings.size(); i++)
+        for (int i = 0; i < (int)mActionStates.size(); i++)
         {
-            if (InputPressed(key, i))
+            if (InputReleased(action, i))
                 return true;
         }
         return false;
     }
-    else
+
+    ActionState *state = GetActionState(action, player);
+    return state && state->released;
+}
+bool Game::InputReleased(const std::string &key, int player)
+{
+    return InputReleased(GetActionId(key), player);
+}
+
+int Game::InputsDir(ActionId negAction, ActionId posAction, int player)
+{
+    return ((bool)Input(posAction, player)) - ((bool)Input(negAction, player));
+}
+int Game::InputsDir(const std::string &negKey, const std::string &posKey, int player)
+{
+    return InputsDir(GetActionId(negKey), GetActionId(posKey), player);
+}
+int Game::InputsPressedDir(ActionId negAction, ActionId posAction, int player)
+{
+    return ((bool)InputPressed(posAction, player)) - ((bool)InputPressed(negAction, player));
+}
+int Game::InputsPressedDir(const std::string &negKey, const std::string &posKey, int player)
+{
+    return InputsPressedDir(GetActionId(negKey), GetActionId(posKey), player);
+}
+
+float Game::InputValue(ActionId action, int player)
+{
+    if (player < 0)
     {
-        if (player >= mInputMappings.size())
-            return 0;
-        auto it = mInputMappings[player].find(key);
-        if (it == mInputMappings[player].end())
-            return 0;
-        return it->second.second.first == 1;
+        float maxVal = 0;
+        for (int i = 0; i < (int)mActionStates.size(); i++)
+            maxVal = Max(maxVal, InputValue(action, i));
+        return maxVal;
     }
+
+    ActionState *state = GetActionState(action, player);
+    return state ? state->value : 0.0f;
+}
+float Game::InputValue(const std::string &key, int player)
+{
+    return InputValue(GetActionId(key), player);
 }
 
-int Game::InputsDir(std::string negKey, std::string posKey, int player)
+float Game::InputsAxis(ActionId negAction, ActionId posAction, int player)
 {
-    return ((bool)Input(posKey, player)) - ((bool)Input(negKey, player));
+    return InputValue(posAction, player) - InputValue(negAction, player);
 }
-int Game::InputsPressedDir(std::string negKey, std::string posKey, int player)
+float Game::InputsAxis(const std::string &negKey, const std::string &posKey, int player)
 {
-    return ((bool)InputPressed(posKey, player)) - ((bool)InputPressed(negKey, player));
+    return InputsAxis(GetActionId(negKey), GetActionId(posKey), player);
 }
 
-void Game::SetInputMapping(std::string key, std::vector<Uint8> inputs, int player)
+ActionId Game::RegisterAction(const std::string &key)
 {
+    auto it = mActionIds.find(key);
+    if (it != mActionIds.end())
+        return it->second;
+
+    ActionId action = (ActionId)mActionIds.size();
+    mActionIds[key] = action;
+    for (auto &playerActions : mActionStates)
+        playerActions.resize(action + 1);
+    return action;
+}
+
+ActionId Game::GetActionId(const std::string &key) const
+{
+    auto it = mActionIds.find(key);
+    return it != mActionIds.end() ? it->second : kNoAction;
+}
+
+ActionId Game::SetInputMapping(const std::string &key, std::vector<InputCode> inputs, int player)
+{
+    ActionId action = RegisterAction(key);
+    auto invalid = std::remove_if(inputs.begin(), inputs.end(), [](InputCode input)
+                                  { return input >= kNumInputCodes; });
+    if (invalid != inputs.end())
+    {
+        PrintLog("Ignoring invalid input codes mapped to", key);
+        inputs.erase(invalid, inputs.end());
+    }
+
     if (player < 0)
     {
-        for (int i = 0; i < mInputMappings.size(); i++)
+        for (int i = 0; i < (int)mActionStates.size(); i++)
             SetInputMapping(key, inputs, i);
     }
     else
     {
-        while (mInputMappings.size() < player + 1)
-            mInputMappings.push_back({});
-        mInputMappings[player][key] = std::make_pair(inputs, std::make_pair(0, 0.0f));
+        while ((int)mActionStates.size() < player + 1)
+            mActionStates.emplace_back(mActionIds.size());
+        ActionState &state = mActionStates[player][action];
+        state.inputs = inputs;
+        state.mapped = true;
+        state.frames = 0;
+        state.time = 0.0f;
+        state.value = 0.0f;
     }
+    return action;
 }
 
 void Game::SetInputMappings(
-    std::vector<std::pair<std::string, std::vector<Uint8>>> inputMappings, int player)
+    std::vector<std::pair<std::string, std::vector<InputCode>>> inputMappings, int player)
 {
     for (auto &[name, inputs] : inputMappings)
         Game::SetInputMapping(name, inputs, player);
 }
 
-std::vector<Uint8> *Game::GetInputMapping(std::string key, int player)
+std::vector<InputCode> *Game::GetInputMapping(const std::string &key, int player)
 {
     if (player < 0)
     {
-        for (int i = 0; i < player; i++)
+        for (int i = 0; i < (int)mActionStates.size(); i++)
         {
             auto ptr = GetInputMapping(key, i);
             if (ptr)
                 return ptr;
         }
+        return nullptr;
     }
-    else if (player < mInputMappings.size())
-    {
-        auto loc = mInputMappings[player].find(key);
-        if (loc != mInputMappings[player].end())
-            return &loc->second.first;
-    }
+
+    ActionState *state = GetActionState(GetActionId(key), player);
+    if (state && state->mapped)
+        return &state->inputs;
     return nullptr;
 }
 
-bool Game::InputExists(std::string key, Uint8 input, int player)
+bool Game::InputExists(const std::string &key, InputCode input, int player)
 {
     if (player < 0)
     {
-        for (int i = 0; i < mInputMappings.size(); i++)
+        for (int i = 0; i < (int)mActionStates.size(); i++)
         {
-            if (InputExists(key, i))
+            if (InputExists(key, input, i))
                 return true;
         }
         return false;
@@ -289,6 +472,60 @@ bool Game::InputExists(std::string key, Uint8 input, int player)
     return (loc != ptr->end());
 }
 
+void Game::SetActionCallback(ActionId action, ActionCallback callback)
+{
+    if (action < 0)
+        return;
+    if (action >= (int)mActionCallbacks.size())
+        mActionCallbacks.resize(action + 1);
+    mActionCallbacks[action] = callback;
+}
+void Game::SetActionCallback(const std::string &key, ActionCallback callback)
+{
+    SetActionCallback(RegisterAction(key), callback);
+}
+
+void Game::QueueInputEvent(InputCode input, bool down, Uint32 timestamp, int player)
+{
+    InputEvent event = {input, down, timestamp, player};
+    mInputEvents.push_back(event);
+    if (down)
+    {
+        Uint8 &presses = player >= 0 ? mGamepads[player].presses[input - PAD_A] : mInputPresses[input];
+        if (presses < 255)
+            presses++;
+    }
+
+    // Gamepad events only trigger their own player's actions
+    int firstPlayer = player >= 0 ? player : 0;
+    int lastPlayer = player >= 0 ? Min(player, (int)mActionStates.size() - 1) : (int)mActionStates.size() - 1;
+    for (ActionId action = 0; action < (int)mActionCallbacks.size(); action++)
+    {
+        if (!mActionCallbacks[action])
+            continue;
+        for (int i = firstPlayer; i <= lastPlayer; i++)
+        {
+            if (action >= (int)mActionStates[i].size())
+                continue;
+            const std::vector<InputCode> &inputs = mActionStates[i][action].inputs;
+            if (std::find(inputs.begin(), inputs.end(), input) != inputs.end())
+                mActionCallbacks[action](action, i, event);
+        }
+    }
+}
+
+void Game::SetInputState(InputCode input, bool down)
+{
+    if (input >= kNumInputCodes)
+        return;
+    mScriptedStates[input] = down;
+}
+
+void Game::ClearInputStates()
+{
+    std::fill(std::begin(mScriptedStates), std::end(mScriptedStates), 0);
+}
+
 void Game::FlushPollEvents()
 {
     SDL_Event event;
@@ -26,7 +26,7 @@ void Game::LoadActor(rapidjson::Value &actorRef, Scene &newScene)
 
     Actor *actor = it->second();
     actor->SetPersistent(Json::GetBool(actorObj, "persistent", false));
-    actor->mId = Json::GetString(actorObj, "id");
+    actor->SetId(Json::GetString(actorObj, "id"));
 
     actor->SetDepth(Json::GetNumber<int>(actorObj, "depth", actor->GetDepth()));
     std::string layerId = Json::GetString(actorObj, "layer");
@@ -110,7 +110,9 @@ void Game::LoadActor(rapidjson::Value &actorRef, Scene &newScene)
         if (tileset)
         {
             tileset->SetTileSize(Json::GetVec2<int>(actorObj, "tileSize", Vec2<int>::Zero));
-            tileset->SetTiles(Json::GetNumberArray2D<int>(actorObj, "tiles"));
+            int width = 0, height = 0;
+            std::vector<int> tiles = Json::GetNumberGrid<int>(actorObj, "tiles", width, height, -1);
+            tileset->SetTiles(TileGrid(width, height, std::move(tiles)));
 
             if (actorObj.HasMember("colliders") && actorObj["colliders"].IsArray())
             {
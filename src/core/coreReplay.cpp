@@ -0,0 +1,244 @@
+#include "Game.h"
+#include "RandLib.h"
+
+#include <cstring>
+
+using namespace junebug;
+
+// Recordings are little-endian binary files
+// Header: "JBIR", Uint16 version, Uint32 random seed
+// Each update: float delta time, Uint8 flags, [Sint32 mouse x, Sint32 mouse y if the mouse moved],
+// Uint16 change count, then for each change: Uint16 input code, Uint8 state
+// Since version 2, each update ends with the gamepads: Uint8 player count, then for each player:
+// Uint8 change count, then for each change: Uint8 input index from PAD_A, Uint8 state, float value
+// A state of 2 means the input was released and pressed again within the update
+static const char kReplayMagic[4] = {'J', 'B', 'I', 'R'};
+static const Uint16 kReplayVersion = 2;
+static const Uint8 kReplayMouseMoved = 1 << 0;
+static const Uint8 kReplayRepressed = 2;
+
+static_assert(kNumInputCodes >= SDL_NUM_SCANCODES, "Replay states stand in for SDL's keyboard state");
+
+void Game::SeedRandom(unsigned int seed)
+{
+    mRandomSeed = seed;
+    Random::Seed(seed);
+    srand(seed);
+}
+
+bool Game::StartRecording(const std::string &path)
+{
+    StopRecording();
+    StopReplay();
+
+    mRecordFile = SDL_RWFromFile(path.c_str(), "wb");
+    if (!mRecordFile)
+    {
+        PrintLog("Failed to open input recording", path);
+        return false;
+    }
+
+    // Pick a fresh seed unless one was set, so the recording starts from a known random state
+    unsigned int seed = options.randomSeed >= 0 ? (unsigned int)options.randomSeed : (unsigned int)time(NULL);
+    SeedRandom(seed);
+    options.randomSeed = -2;
+
+    SDL_RWwrite(mRecordFile, kReplayMagic, 1, 4);
+    SDL_WriteLE16(mRecordFile, kReplayVersion);
+    SDL_WriteLE32(mRecordFile, seed);
+
+    // The first frame records every input that's already held
+    std::fill(std::begin(mRecordedStates), std::end(mRecordedStates), 0);
+    mRecordedPadValues.clear();
+    mRecordedMousePos = Vec2<int>(INT32_MIN, INT32_MIN);
+    return true;
+}
+
+void Game::StopRecording()
+{
+    if (!mRecordFile)
+        return;
+    SDL_RWclose(mRecordFile);
+    mRecordFile = nullptr;
+}
+
+bool Game::StartReplay(const std::string &path)
+{
+    StopRecording();
+    StopReplay();
+
+    mReplayFile = SDL_RWFromFile(path.c_str(), "rb");
+    if (!mReplayFile)
+    {
+        PrintLog("Failed to open input recording", path);
+        return false;
+    }
+
+    char magic[4];
+    if (SDL_RWread(mReplayFile, magic, 1, 4) != 4 || memcmp(magic, kReplayMagic, 4) != 0)
+    {
+        PrintLog("Not an input recording:", path);
+        StopReplay();
+        return false;
+    }
+    Uint16 version = SDL_ReadLE16(mReplayFile);
+    if (version < 1 || version > kReplayVersion)
+    {
+        PrintLog("Unsupported input recording version", version, "in", path);
+        StopReplay();
+        return false;
+    }
+    mReplayVersion = version;
+
+    SeedRandom(SDL_ReadLE32(mReplayFile));
+    options.randomSeed = -2;
+
+    std::fill(std::begin(mReplayStates), std::end(mReplayStates), 0);
+    return true;
+}
+
+void Game::StopReplay()
+{
+    if (!mReplayFile)
+        return;
+    SDL_RWclose(mReplayFile);
+    mReplayFile = nullptr;
+    std::fill(std::begin(mReplayStates), std::end(mReplayStates), 0);
+    for (Gamepad &pad : mGamepads)
+        std::fill(std::begin(pad.values), std::end(pad.values), 0.0f);
+}
+
+void Game::WriteRecordingFrame(const Uint8 *state)
+{
+    Uint32 dtBits;
+    memcpy(&dtBits, &mDeltaTime, sizeof(dtBits));
+    SDL_WriteLE32(mRecordFile, dtBits);
+
+    bool mouseMoved = mMouseScreenPos != mRecordedMousePos;
+    SDL_WriteU8(mRecordFile, mouseMoved ? kReplayMouseMoved : 0);
+    if (mouseMoved)
+    {
+        SDL_WriteLE32(mRecordFile, (Uint32)mMouseScreenPos.x);
+        SDL_WriteLE32(mRecordFile, (Uint32)mMouseScreenPos.y);
+        mRecordedMousePos = mMouseScreenPos;
+    }
+
+    // Most frames change nothing, so only inputs that changed are written
+    // Presses shorter than a frame are recorded as held for that frame
+    Uint16 numChanges = 0;
+    InputCode changed[PAD_A];
+    Uint8 changedStates[PAD_A];
+    for (int input = 0; input < PAD_A; input++)
+    {
+        Uint8 down = (state[input] || mExtraStates[input] || mInputPresses[input]) ? 1 : 0;
+        if (down != mRecordedStates[input] || (mInputPresses[input] && mRecordedStates[input]))
+        {
+            changed[numChanges] = (InputCode)input;
+            changedStates[numChanges++] = down == mRecordedStates[input] ? kReplayRepressed : down;
+            mRecordedStates[input] = down;
+        }
+    }
+
+    SDL_WriteLE16(mRecordFile, numChanges);
+    for (Uint16 i = 0; i < numChanges; i++)
+    {
+        SDL_WriteLE16(mRecordFile, changed[i]);
+        SDL_WriteU8(mRecordFile, changedStates[i]);
+    }
+
+    // Gamepads are written the same way, with their analog values
+    int numPlayers = Min((int)mGamepads.size(), 255);
+    if ((int)mRecordedPadValues.size() < numPlayers)
+        mRecordedPadValues.resize(numPlayers, std::vector<float>(kNumPadInputs, 0.0f));
+    SDL_WriteU8(mRecordFile, (Uint8)numPlayers);
+    for (int player = 0; player < numPlayers; player++)
+    {
+        Gamepad &pad = mGamepads[player];
+        std::vector<float> &recorded = mRecordedPadValues[player];
+
+        Uint8 numPadChanges = 0;
+        Uint8 padChanged[kNumPadInputs], padStates[kNumPadInputs];
+        for (int i = 0; i < kNumPadInputs; i++)
+        {
+            // A press released before this update is recorded as fully held
+            float value = pad.values[i] > 0.0f || !pad.presses[i] ? pad.values[i] : 1.0f;
+            bool down = value > 0.0f, wasDown = recorded[i] > 0.0f;
+            if (value != recorded[i] || (pad.presses[i] && wasDown))
+            {
+                padChanged[numPadChanges] = (Uint8)i;
+                padStates[numPadChanges++] = pad.presses[i] && wasDown ? kReplayRepressed : down;
+                recorded[i] = value;
+            }
+        }
+
+        SDL_WriteU8(mRecordFile, numPadChanges);
+        for (Uint8 i = 0; i < numPadChanges; i++)
+        {
+            Uint32 valueBits;
+            memcpy(&valueBits, &recorded[padChanged[i]], sizeof(valueBits));
+            SDL_WriteU8(mRecordFile, padChanged[i]);
+            SDL_WriteU8(mRecordFile, padStates[i]);
+            SDL_WriteLE32(mRecordFile, valueBits);
+        }
+    }
+}
+
+void Game::ReadReplayFrame()
+{
+    Uint32 dtBits;
+    if (SDL_RWread(mReplayFile, &dtBits, sizeof(dtBits), 1) != 1)
+    {
+        Log("Replay finished after", mFrameCount, "frames");
+        StopReplay();
+        if (options.quitAfterReplay)
+            mGameIsRunning = false;
+        return;
+    }
+    dtBits = SDL_SwapLE32(dtBits);
+    memcpy(&mDeltaTime, &dtBits, sizeof(mDeltaTime));
+
+    Uint8 flags = SDL_ReadU8(mReplayFile);
+    if (flags & kReplayMouseMoved)
+    {
+        Sint32 x = (Sint32)SDL_ReadLE32(mReplayFile);
+        Sint32 y = (Sint32)SDL_ReadLE32(mReplayFile);
+        SetMouseScreenPos(Vec2<int>(x, y));
+    }
+
+    // Replayed changes become input events, so presses and callbacks behave as they did when recorded
+    Uint32 timestamp = SDL_GetTicks();
+    Uint16 numChanges = SDL_ReadLE16(mReplayFile);
+    for (Uint16 i = 0; i < numChanges; i++)
+    {
+        Uint16 input = SDL_ReadLE16(mReplayFile);
+        Uint8 down = SDL_ReadU8(mReplayFile);
+        if (input >= PAD_A)
+            continue;
+        if (down == kReplayRepressed)
+            QueueInputEvent((InputCode)input, false, timestamp);
+        mReplayStates[input] = down ? 1 : 0;
+        QueueInputEvent((InputCode)input, mReplayStates[input], timestamp);
+    }
+
+    if (mReplayVersion < 2)
+        return;
+
+    Uint8 numPlayers = SDL_ReadU8(mReplayFile);
+    for (int player = 0; player < numPlayers; player++)
+    {
+        Uint8 numPadChanges = SDL_ReadU8(mReplayFile);
+        for (Uint8 i = 0; i < numPadChanges; i++)
+        {
+            Uint8 pad = SDL_ReadU8(mReplayFile);
+            Uint8 padState = SDL_ReadU8(mReplayFile);
+            Uint32 valueBits = SDL_ReadLE32(mReplayFile);
+            float value;
+            memcpy(&value, &valueBits, sizeof(value));
+            if (pad >= kNumPadInputs)
+                continue;
+            if (padState == kReplayRepressed)
+                SetPadValue(player, pad, 0.0f, timestamp);
+            SetPadValue(player, pad, value, timestamp);
+        }
+    }
+}
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "Background.h"
 #include "Transitions.h"
 
+#include <unordered_set>
+
 using namespace junebug;
 
 void Game::ChangeScene(std::string scene)
@@ -55,11 +57,88 @@ const Scene &Game::GetCurrentScene() const
     return mScene;
 }
 
+std::unique_ptr<Json> Game::LoadSceneJson(std::string &sceneStr)
+{
+    if (sceneStr == "")
+        return nullptr;
+
+    std::unique_ptr<Json> json;
+    if (sceneStr[0] == '{')
+        json = std::make_unique<Json>(sceneStr);
+    else
+    {
+        if (!StringEndsWith(sceneStr, ".json"))
+            sceneStr += ".json";
+
+        json = std::make_unique<Json>(GetAssetPaths().scenes + sceneStr, true);
+        if (!json->IsValid())
+            json = std::make_unique<Json>(sceneStr, true);
+    }
+
+    if (!json->IsValid())
+        return nullptr;
+    return json;
+}
+
+static void GetManifestFromJson(Json *json, std::vector<std::string> &sprites)
+{
+    Document *doc = json->GetDoc();
+    if (!doc->HasMember("actors") || !(*doc)["actors"].IsArray())
+        return;
+
+    // Tilesets and backgrounds store their image in the same "sprite" field as every other actor
+    std::unordered_set<std::string> seen;
+    for (auto &actorRef : (*doc)["actors"].GetArray())
+    {
+        if (!actorRef.IsObject())
+            continue;
+        std::string sprite = Json::GetString(actorRef.GetObject(), "sprite");
+        if (sprite != "" && seen.insert(sprite).second)
+            sprites.push_back(sprite);
+    }
+}
+
+std::vector<std::string> Game::GetSceneManifest(std::string scene)
+{
+    std::vector<std::string> sprites;
+    auto it = mPrefetchedScenes.find(scene);
+    if (it != mPrefetchedScenes.end())
+    {
+        GetManifestFromJson(it->second.get(), sprites);
+        return sprites;
+    }
+
+    std::string sceneStr = scene;
+    std::unique_ptr<Json> json = LoadSceneJson(sceneStr);
+    if (json)
+        GetManifestFromJson(json.get(), sprites);
+    return sprites;
+}
+
+void Game::PrefetchScene(std::string scene)
+{
+    if (scene == "" || mPrefetchedScenes.find(scene) != mPrefetchedScenes.end())
+        return;
+
+    std::string sceneStr = scene;
+    std::unique_ptr<Json> json = LoadSceneJson(sceneStr);
+    if (!json)
+        return;
+
+    std::vector<std::string> sprites;
+    GetManifestFromJson(json.get(), sprites);
+    for (auto &sprite : sprites)
+        PreloadSprite(sprite, scene);
+
+    mPrefetchedScenes[scene] = std::move(json);
+}
+
 void Game::LoadQueuedScenes()
 {
     while (!mSceneQueue.empty())
     {
         std::string sceneStr = mSceneQueue.front();
+        std::string sceneKey = sceneStr;
         mSceneQueue.pop();
 
         Scene newScene;
@@ -73,36 +152,42 @@ void Game::LoadQueuedScenes()
                 mSceneInfo = nullptr;
             }
 
-            if (sceneStr[0] == '{')
-                mSceneInfo = new Json(sceneStr);
-            else
+            auto prefetched = mPrefetchedScenes.find(sceneKey);
+            std::unique_ptr<Json> json;
+            if (prefetched != mPrefetchedScenes.end())
             {
-                if (!StringEndsWith(sceneStr, ".json"))
+                json = std::move(prefetched->second);
+                if (sceneStr[0] != '{' && !StringEndsWith(sceneStr, ".json"))
                     sceneStr += ".json";
 
-                mSceneInfo = new Json(GetAssetPaths().scenes + sceneStr, true);
-                if (!mSceneInfo->IsValid())
-                    mSceneInfo = new Json(sceneStr, true);
+                // Upload whatever the background loader hasn't finished yet, so actors don't load sprites one at a time
+                mAssetLoader.Finish(sceneKey);
             }
+            else
+                json = LoadSceneJson(sceneStr);
+            // Scenes prefetched for a transition that didn't happen are dropped, so they don't pile up
+            // Their sprites stay cached like any other loaded sprite
+            mPrefetchedScenes.clear();
 
-            if (!mSceneInfo->IsValid())
+            if (!json)
             {
                 PrintLog("Scene", sceneStr, "is invalid");
                 continue;
             }
+            mSceneInfo = json.release();
 
             // Unload the current scene
             int numPersistentActors = 0;
-            std::vector<Actor *> destroyActors;
             for (Actor *actor : mActors)
             {
+                if (!actor)
+                    continue;
                 if (!actor->IsPersistent())
-                    destroyActors.push_back(actor);
+                    actor->Destroy();
                 else
                     numPersistentActors++;
             }
-            for (Actor *actor : destroyActors)
-                delete actor;
+            DestroyQueuedActors();
             mScene.layers.clear();
 
             // Load the new scene
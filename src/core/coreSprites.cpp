@@ -10,6 +10,8 @@ SDL_Texture *Game::GetTexture(std::string fileName)
     auto it = mTextures.find(fileName);
     if (it != mTextures.end())
         return it->second;
+    if (!mRenderer)
+        return nullptr;
 
     SDL_Surface *surface = IMG_Load(fileName.c_str());
     SDL_Texture *texture = SDL_CreateTextureFromSurface(mRenderer, surface);
@@ -22,4 +24,73 @@ SDL_Texture *Game::GetTexture(std::string fileName)
 
     mTextures.insert(std::make_pair(fileName, texture));
     return texture;
+}
+
+TextureRegion Game::GetTextureRegion(std::string fileName)
+{
+    TextureRegion region;
+    if (FindTextureRegion(fileName, region))
+        return region;
+
+    SDL_Surface *surface = IMG_Load(fileName.c_str());
+    if (!surface)
+    {
+        PrintLog("Failed to load", "'" + fileName + "'");
+        return region;
+    }
+
+    region = AddTextureSurface(fileName, surface);
+    SDL_FreeSurface(surface);
+    return region;
+}
+
+bool Game::FindTextureRegion(const std::string &fileName, TextureRegion &region)
+{
+    if (mAtlas.Find(fileName, region))
+        return true;
+
+    auto it = mTextures.find(fileName);
+    if (it == mTextures.end() || !it->second)
+        return false;
+
+    region.texture = it->second;
+    region.rect = {0, 0, 0, 0};
+    SDL_QueryTexture(region.texture, nullptr, nullptr, &region.rect.w, &region.rect.h);
+    return true;
+}
+
+TextureRegion Game::AddTextureSurface(const std::string &fileName, SDL_Surface *surface)
+{
+    TextureRegion region;
+    if (!surface)
+        return region;
+
+    // Headless games have no renderer, but frames still need their size for origins and colliders
+    if (!mRenderer)
+    {
+        region.rect = {0, 0, surface->w, surface->h};
+        return region;
+    }
+
+    // Images too large for a page fall back to their own texture
+    if (!options.textureAtlas || !mAtlas.Insert(fileName, surface, region))
+    {
+        region.texture = SDL_CreateTextureFromSurface(mRenderer, surface);
+        if (region.texture)
+        {
+            region.rect = {0, 0, surface->w, surface->h};
+            mTextures.insert(std::make_pair(fileName, region.texture));
+        }
+        else
+            PrintLog("Failed to load", "'" + fileName + "'");
+    }
+
+    return region;
+}
+
+void Game::PreloadSprite(std::string imagePath, std::string group)
+{
+    if (imagePath == "")
+        return;
+    mAssetLoader.PreloadSprite(GetAssetPaths().sprites + imagePath, group);
 }
\ No newline at end of file